@@ -0,0 +1,108 @@
+#ifndef PGSTL_BENCH_H
+#define PGSTL_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+/**
+ * 阻止编译器把只用于计时的计算优化掉
+ */
+template<class T>
+inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+inline double elapsed_ns(clock::time_point start) {
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+}
+
+/**
+ * 运行 f 若干轮，返回最快一轮的耗时（纳秒），用来减少调度和缓存预热带来的噪声
+ */
+template<class F>
+double best_of(int rounds, F f) {
+    double best = 0;
+    for (int i = 0; i < rounds; ++i) {
+        clock::time_point start = clock::now();
+        f();
+        double ns = elapsed_ns(start);
+        if (i == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+/**
+ * 输出一行结果：名字、每次操作的耗时和吞吐量
+ */
+inline void report(const char *name, double total_ns, size_t ops) {
+    double per_op = ops ? total_ns / double(ops) : 0;
+    std::printf("%-48s %10.2f ns/op %10.2f Mops/s\n", name, per_op,
+                per_op > 0 ? 1000.0 / per_op : 0.0);
+}
+
+/**
+ * 收集单次操作的耗时，输出分位数，用来观察尾延迟而不只是平均值
+ */
+class latency_histogram {
+public:
+    explicit latency_histogram(size_t expected = 0) { _samples.reserve(expected); }
+
+    void record(double ns) { _samples.push_back(ns); }
+
+    double percentile(double p) {
+        if (_samples.empty())
+            return 0;
+        std::sort(_samples.begin(), _samples.end());
+        size_t i = size_t(p / 100.0 * double(_samples.size() - 1) + 0.5);
+        return _samples[i];
+    }
+
+    void report(const char *name) {
+        std::printf("%-48s p50 %8.0f  p90 %8.0f  p99 %8.0f  p99.9 %8.0f  max %8.0f ns\n", name,
+                    percentile(50), percentile(90), percentile(99), percentile(99.9), percentile(100));
+    }
+
+private:
+    std::vector<double> _samples;
+};
+
+struct bench_case {
+    const char *name;
+    void (*run)();
+};
+
+inline std::vector<bench_case> &registry() {
+    static std::vector<bench_case> cases;
+    return cases;
+}
+
+struct registrar {
+    registrar(const char *name, void (*run)()) {
+        registry().push_back(bench_case{name, run});
+    }
+};
+
+}
+
+/**
+ * 定义并注册一组基准测试，pgstl_bench [过滤串] 只运行名字中包含过滤串的组
+ */
+#define PGSTL_BENCH(name)                                          \
+    static void name();                                            \
+    static bench::registrar name##_registrar(#name, name);         \
+    static void name()
+
+#endif //PGSTL_BENCH_H
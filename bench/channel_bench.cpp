@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "channel.h"
+
+namespace {
+
+const size_t items = 400000;
+const size_t capacity = 1024;
+const size_t batch = 64;
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            bench::clock::now().time_since_epoch()).count();
+}
+
+/**
+ * producers 个线程一共放入 items 个元素，一个消费者取出
+ * 元素是放入时的时间戳，消费者据此记录从 push 到 pop 的延迟
+ */
+void runChannel(size_t producers, bool batched) {
+    pgstl::channel<int64_t> ch(capacity);
+    bench::latency_histogram hist(items);
+    size_t per_producer = items / producers;
+
+    bench::clock::time_point start = bench::clock::now();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&ch, per_producer, batched] {
+            int64_t buf[batch];
+            for (size_t i = 0; i < per_producer;) {
+                if (batched) {
+                    size_t n = per_producer - i < batch ? per_producer - i : batch;
+                    for (size_t k = 0; k < n; ++k)
+                        buf[k] = now_ns();
+                    i += ch.push_n(buf, buf + n);
+                } else {
+                    ch.push(now_ns());
+                    ++i;
+                }
+            }
+        });
+    }
+
+    int64_t buf[batch];
+    for (size_t received = 0; received < per_producer * producers;) {
+        size_t n = batched ? ch.pop_n(buf, batch) : size_t(ch.pop(buf[0]));
+        int64_t t = now_ns();
+        for (size_t k = 0; k < n; ++k)
+            hist.record(double(t - buf[k]));
+        received += n;
+    }
+    double ns = bench::elapsed_ns(start);
+    for (std::thread &t : threads)
+        t.join();
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "channel %zu producer(s)%s", producers, batched ? " push_n/pop_n" : "");
+    bench::report(name, ns, per_producer * producers);
+    hist.report(name);
+}
+
+}
+
+PGSTL_BENCH(channel_throughput) {
+    const size_t producers[] = {1, 2, 4, 8};
+    for (size_t p : producers) {
+        runChannel(p, false);
+        runChannel(p, true);
+    }
+}
@@ -0,0 +1,81 @@
+#include <list>
+#include <string>
+
+#include "bench.h"
+#include "list.h"
+
+namespace {
+
+const size_t count = 200000;
+const int rounds = 5;
+
+// 带有用户定义（非平凡）析构函数的 int，用来对比 destroyNode 的两条路径
+struct NonTrivialInt {
+    int v;
+
+    NonTrivialInt(int x = 0) : v(x) {}
+    ~NonTrivialInt() { bench::do_not_optimize(v); }
+
+    bool operator<(const NonTrivialInt &x) const { return v < x.v; }
+    bool operator==(const NonTrivialInt &x) const { return v == x.v; }
+};
+
+template<class T>
+T makeValue(size_t i) { return T(int((i * 2654435761u) % count)); }
+
+template<>
+std::string makeValue<std::string>(size_t i) {
+    return "key-" + std::to_string((i * 2654435761u) % count);
+}
+
+template<class List>
+void runList(const char *label) {
+    using T = typename List::value_type;
+    char name[96];
+
+    double ns = bench::best_of(rounds, [] {
+        List l;
+        for (size_t i = 0; i < count; ++i)
+            l.push_back(makeValue<T>(i));
+        bench::do_not_optimize(l);
+    });
+    std::snprintf(name, sizeof(name), "%s build+destroy", label);
+    bench::report(name, ns, count);
+
+    List l;
+    for (size_t i = 0; i < count; ++i)
+        l.push_back(makeValue<T>(i));
+    // 只统计 clear 本身，拷贝的时间不计入
+    ns = 0;
+    for (int r = 0; r < rounds; ++r) {
+        List tmp(l);
+        bench::clock::time_point start = bench::clock::now();
+        tmp.clear();
+        double t = bench::elapsed_ns(start);
+        bench::do_not_optimize(tmp);
+        if (r == 0 || t < ns)
+            ns = t;
+    }
+    std::snprintf(name, sizeof(name), "%s clear", label);
+    bench::report(name, ns, count);
+
+    ns = bench::best_of(rounds, [&] {
+        List tmp(l);
+        tmp.sort();
+        bench::do_not_optimize(tmp);
+    });
+    std::snprintf(name, sizeof(name), "%s copy+sort", label);
+    bench::report(name, ns, count);
+}
+
+}
+
+PGSTL_BENCH(list_element_types) {
+    runList<pgstl::list<int>>("pgstl::list<int>");
+    runList<pgstl::list<NonTrivialInt>>("pgstl::list<non-trivial int>");
+    runList<std::list<int>>("std::list<int>");
+    runList<pgstl::list<double>>("pgstl::list<double>");
+    runList<std::list<double>>("std::list<double>");
+    runList<pgstl::list<std::string>>("pgstl::list<std::string>");
+    runList<std::list<std::string>>("std::list<std::string>");
+}
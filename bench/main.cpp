@@ -0,0 +1,15 @@
+#include <cstdio>
+#include <cstring>
+
+#include "bench.h"
+
+int main(int argc, char **argv) {
+    const char *filter = argc > 1 ? argv[1] : nullptr;
+    for (const bench::bench_case &c : bench::registry()) {
+        if (filter && !std::strstr(c.name, filter))
+            continue;
+        std::printf("== %s\n", c.name);
+        c.run();
+    }
+    return 0;
+}
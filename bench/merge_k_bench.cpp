@@ -0,0 +1,77 @@
+#include <vector>
+
+#include "bench.h"
+#include "list.h"
+#include "merge_k.h"
+
+namespace {
+
+const size_t total = 1 << 18;
+const int rounds = 3;
+
+using IntList = pgstl::list<int>;
+
+/**
+ * 把 total 个元素按轮转分给 k 个链表，每个链表内部有序
+ */
+void makeRuns(std::vector<IntList> &runs, size_t k) {
+    runs.clear();
+    runs.resize(k);
+    unsigned long long r = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < total; ++i) {
+        r ^= r << 13;
+        r ^= r >> 7;
+        r ^= r << 17;
+        runs[i % k].push_back(int(r >> 33));
+    }
+    for (IntList &l : runs)
+        l.sort();
+}
+
+// 只统计合并本身，每轮重新生成输入
+template<class Merge>
+double timeMerge(size_t k, Merge merge) {
+    std::vector<IntList> runs;
+    double best = 0;
+    for (int i = 0; i < rounds; ++i) {
+        makeRuns(runs, k);
+        bench::clock::time_point start = bench::clock::now();
+        merge(runs);
+        double ns = bench::elapsed_ns(start);
+        bench::do_not_optimize(runs.front());
+        if (i == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+}
+
+PGSTL_BENCH(merge_k) {
+    for (size_t k = 2; k <= 1024; k *= 2) {
+        char name[96];
+
+        double ns = timeMerge(k, [](std::vector<IntList> &runs) {
+            pgstl::merge_k(runs.data(), runs.data() + runs.size());
+        });
+        std::snprintf(name, sizeof(name), "merge_k k=%zu", k);
+        bench::report(name, ns, total);
+
+        // 对照组一：依次合并到第一个链表，O(nk)
+        ns = timeMerge(k, [](std::vector<IntList> &runs) {
+            for (size_t i = 1; i < runs.size(); ++i)
+                runs[0].merge(runs[i]);
+        });
+        std::snprintf(name, sizeof(name), "sequential merge k=%zu", k);
+        bench::report(name, ns, total);
+
+        // 对照组二：两两归并成一棵树，O(n log k)
+        ns = timeMerge(k, [](std::vector<IntList> &runs) {
+            for (size_t step = 1; step < runs.size(); step *= 2)
+                for (size_t i = 0; i + step < runs.size(); i += 2 * step)
+                    runs[i].merge(runs[i + step]);
+        });
+        std::snprintf(name, sizeof(name), "pairwise merge k=%zu", k);
+        bench::report(name, ns, total);
+    }
+}
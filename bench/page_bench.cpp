@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <cstring>
+
+#include "bench.h"
+#include "list.h"
+#include "page_allocator.h"
+
+namespace {
+
+// 32M 的节点，远大于 4K 页时 TLB 能覆盖的范围
+const size_t count = 1 << 20;
+const int rounds = 5;
+
+using PageList = pgstl::list<int, pgstl::page_allocator<int>>;
+using HeapList = pgstl::list<int>;
+
+/**
+ * 按随机的键建表后排序，遍历顺序在内存中随机跳跃，主要开销是缓存和 TLB 未命中
+ */
+template<class List>
+void build(List &l) {
+    unsigned long long r = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < count; ++i) {
+        r ^= r << 13;
+        r ^= r >> 7;
+        r ^= r << 17;
+        l.push_back(int(r >> 33));
+    }
+    l.sort();
+}
+
+template<class List>
+void traverse(const char *label, const List &l) {
+    double ns = bench::best_of(rounds, [&l] {
+        long sum = 0;
+        for (int x : l)
+            sum += x;
+        bench::do_not_optimize(sum);
+    });
+    bench::report(label, ns, count);
+}
+
+void printHugePageMode() {
+    std::FILE *f = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    char mode[128] = "unknown";
+    if (f) {
+        if (!std::fgets(mode, sizeof(mode), f))
+            mode[0] = '\0';
+        std::fclose(f);
+    }
+    std::printf("transparent_hugepage: %s%s", mode, mode[0] && mode[std::strlen(mode) - 1] == '\n' ? "" : "\n");
+}
+
+// 当前进程实际拿到的透明大页，用来确认 madvise 是否生效
+void printAnonHugePages() {
+    std::FILE *f = std::fopen("/proc/self/smaps_rollup", "r");
+    if (!f)
+        return;
+    char line[128];
+    while (std::fgets(line, sizeof(line), f))
+        if (std::strncmp(line, "AnonHugePages:", 14) == 0)
+            std::printf("%s", line);
+    std::fclose(f);
+}
+
+}
+
+PGSTL_BENCH(page_traversal) {
+    printHugePageMode();
+
+    // 所有链表同时存活，避免后建的链表复用前一个释放回内存池的节点
+    PageList small;
+    PageList thp;
+    PageList huge;
+    HeapList heap;
+
+    pgstl::page_arena &arena = pgstl::page_arena::local();
+    arena.configure(pgstl::small_pages);
+    build(small);
+    arena.configure(pgstl::transparent_huge_pages);
+    build(thp);
+    arena.configure(pgstl::huge_pages);
+    build(huge);
+    arena.configure(pgstl::transparent_huge_pages);
+    build(heap);
+    printAnonHugePages();
+
+    traverse("page_allocator 4K pages", small);
+    traverse("page_allocator transparent 2M pages", thp);
+    traverse("page_allocator MAP_HUGETLB 2M pages", huge);
+    traverse("allocator (operator new)", heap);
+}
@@ -0,0 +1,87 @@
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "concurrent_skip_list.h"
+
+namespace {
+
+const size_t opsPerThread = 200000;
+const unsigned keyRange = 100000;
+
+// 对照组：一把全局锁保护的 std::set
+class locked_set {
+public:
+    bool insert(unsigned x) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _set.insert(x).second;
+    }
+    bool erase(unsigned x) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _set.erase(x) != 0;
+    }
+    bool contains(unsigned x) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _set.count(x) != 0;
+    }
+
+private:
+    std::mutex _mutex;
+    std::set<unsigned> _set;
+};
+
+/**
+ * 每个线程执行 opsPerThread 次操作，lookupPercent% 的查找，其余插入和删除各占一半
+ * 预先填入一半的键，让插入和删除都有一定的成功率
+ */
+template<class Set>
+void runMixed(const char *label, int threads, unsigned lookupPercent) {
+    Set s;
+    for (unsigned k = 0; k < keyRange; k += 2)
+        s.insert(k);
+
+    bench::clock::time_point start = bench::clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&s, t, lookupPercent] {
+            unsigned long long r = 0x9E3779B97F4A7C15ull * unsigned(t + 1);
+            size_t hits = 0;
+            for (size_t i = 0; i < opsPerThread; ++i) {
+                r ^= r << 13;
+                r ^= r >> 7;
+                r ^= r << 17;
+                unsigned key = unsigned(r >> 32) % keyRange;
+                unsigned op = unsigned(r & 0xffff) % 100;
+                if (op < lookupPercent)
+                    hits += s.contains(key);
+                else if (op % 2)
+                    hits += s.insert(key);
+                else
+                    hits += s.erase(key);
+            }
+            bench::do_not_optimize(hits);
+        });
+    }
+    for (std::thread &w : workers)
+        w.join();
+    double ns = bench::elapsed_ns(start);
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "%s %d thread(s) %u%% lookup", label, threads, lookupPercent);
+    bench::report(name, ns, opsPerThread * size_t(threads));
+}
+
+}
+
+PGSTL_BENCH(skip_list_scaling) {
+    const int threads[] = {1, 2, 4, 8};
+    const unsigned lookups[] = {90, 50};
+    for (unsigned lookup : lookups) {
+        for (int t : threads) {
+            runMixed<pgstl::concurrent_skip_list<unsigned>>("concurrent_skip_list", t, lookup);
+            runMixed<locked_set>("mutex + std::set", t, lookup);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#include <list>
+
+#include "bench.h"
+#include "list.h"
+#include "static_list.h"
+
+namespace {
+
+const size_t samples = 100000;
+const size_t elements = 64;
+
+/**
+ * 每个样本模拟一次热路径上的临时链表：构造、填充、遍历、析构
+ * 堆上的链表每个样本要申请和释放 elements 个节点，static_list 一次都不需要
+ */
+template<class List>
+void runLatency(const char *label) {
+    bench::latency_histogram hist(samples);
+    for (size_t s = 0; s < samples; ++s) {
+        bench::clock::time_point start = bench::clock::now();
+        {
+            List l;
+            for (size_t i = 0; i < elements; ++i)
+                l.push_back(int(i ^ s));
+            int sum = 0;
+            for (int x : l)
+                sum += x;
+            bench::do_not_optimize(sum);
+        }
+        hist.record(bench::elapsed_ns(start));
+    }
+    hist.report(label);
+}
+
+}
+
+PGSTL_BENCH(static_list_latency) {
+    runLatency<pgstl::static_list<int, elements>>("pgstl::static_list<int, 64>");
+    runLatency<pgstl::list<int>>("pgstl::list<int>");
+    runLatency<std::list<int>>("std::list<int>");
+}
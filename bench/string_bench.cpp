@@ -0,0 +1,79 @@
+#include <list>
+#include <string>
+
+#include "basic_string.h"
+#include "bench.h"
+#include "list.h"
+
+namespace {
+
+const size_t count = 200000;
+const int rounds = 5;
+
+// 取值范围只有 count / 4，排序后 unique 能删掉大约四分之三的元素
+template<class String>
+String makeKey(size_t i, size_t width) {
+    char buf[64];
+    int n = std::snprintf(buf, sizeof(buf), "%0*zu", int(width), (i * 2654435761u) % (count / 4));
+    return String(buf, size_t(n));
+}
+
+/**
+ * width 为 8 时键都在短字符串缓冲区内，为 32 时每个键都要申请堆内存
+ */
+template<class List>
+void runStrings(const char *label, size_t width) {
+    using String = typename List::value_type;
+    char name[96];
+
+    double ns = bench::best_of(rounds, [width] {
+        List l;
+        for (size_t i = 0; i < count; ++i)
+            l.push_back(makeKey<String>(i, width));
+        bench::do_not_optimize(l);
+    });
+    std::snprintf(name, sizeof(name), "%s w=%zu build+destroy", label, width);
+    bench::report(name, ns, count);
+
+    List l;
+    for (size_t i = 0; i < count; ++i)
+        l.push_back(makeKey<String>(i, width));
+
+    ns = 0;
+    for (int r = 0; r < rounds; ++r) {
+        List tmp(l);
+        bench::clock::time_point start = bench::clock::now();
+        tmp.sort();
+        double sort_ns = bench::elapsed_ns(start);
+        bench::do_not_optimize(tmp);
+        if (r == 0 || sort_ns < ns)
+            ns = sort_ns;
+    }
+    std::snprintf(name, sizeof(name), "%s w=%zu sort", label, width);
+    bench::report(name, ns, count);
+
+    l.sort();
+    ns = 0;
+    for (int r = 0; r < rounds; ++r) {
+        List tmp(l);
+        bench::clock::time_point start = bench::clock::now();
+        tmp.unique();
+        double unique_ns = bench::elapsed_ns(start);
+        bench::do_not_optimize(tmp);
+        if (r == 0 || unique_ns < ns)
+            ns = unique_ns;
+    }
+    std::snprintf(name, sizeof(name), "%s w=%zu unique", label, width);
+    bench::report(name, ns, count);
+}
+
+}
+
+PGSTL_BENCH(string_list) {
+    const size_t widths[] = {8, 32};
+    for (size_t w : widths) {
+        runStrings<pgstl::list<pgstl::string>>("list<pgstl::string>", w);
+        runStrings<pgstl::list<std::string>>("list<std::string>", w);
+        runStrings<std::list<std::string>>("std::list<std::string>", w);
+    }
+}
@@ -3,10 +3,19 @@
 
 #include <cstddef>
 #include <climits>
+#include <new>
+#include <utility>
+
+#include "instrument.h"
 
 namespace pgstl {
 
-template<class T>
+/**
+ * 基于全局 new / delete 的分配器
+ * @tparam T 元素类型
+ * @tparam Instrument 插桩策略，默认的 null_instrument 不产生任何代码
+ */
+template<class T, class Instrument = default_instrument>
 class allocator {
 public:
     using size_type = size_t;
@@ -23,7 +32,7 @@ public:
      */
     template<class U>
     struct rebind {
-        typedef allocator<U> other;
+        typedef allocator<U, Instrument> other;
     };
 
 public:
@@ -31,7 +40,7 @@ public:
     allocator(const allocator &a) noexcept = default;
 
     template<class U>
-    explicit allocator(const allocator<U> &) noexcept {}
+    explicit allocator(const allocator<U, Instrument> &) noexcept {}
 
     ~allocator() noexcept = default;
 
@@ -42,12 +51,14 @@ public:
      * 申请大小为 n 的内存
      * @param n : 申请空间的大小
      * @param hint : 在使用时传一个空指针（将其转换成对应类型）来指明申请什么类型的指针（函数内未使用）
-     * @return 返回申请空间的首地址
+     * @return 返回申请空间的首地址，内存不足时抛出 std::bad_alloc
      */
     T* allocate(size_type n, const void * = nullptr) {
-        // TODO: 这个地方需要抛出bad_alloc异常
-        if (n > max_size() || n < 0)
-            n = 0;
+        typename Instrument::scope probe(allocator_allocate);
+        if (n > max_size())
+            throw std::bad_alloc();
+        // 检查通过之后 n * sizeof(T) 才不会溢出
+        Instrument::record_length(probe, n * sizeof(T));
         return static_cast<T *>(::operator new((size_t) (n * sizeof(T))));
     }
 
@@ -56,37 +67,43 @@ public:
      * @param p 分配空间的首地址
      * @param n 表明分配空间的大小，(在函数内并未使用)
      */
-    void deallocate(pointer p, size_type) { ::operator delete(p); }
+    void deallocate(pointer p, size_type) {
+        typename Instrument::scope probe(allocator_deallocate);
+        ::operator delete(p);
+    }
 
     size_type max_size() const noexcept { return size_type(-1) / sizeof(T); }
 
     void construct(pointer p, const T &value) {
         ::new(static_cast<void *>(p)) T(value);
     }
+    void construct(pointer p, T &&value) {
+        ::new(static_cast<void *>(p)) T(std::move(value));
+    }
 
     void destroy(pointer p) { p->~T(); }
 };
 
 // All allocators are considered equal, as they merely use global new/delete.
-template<typename T1, typename T2>
+template<typename T1, typename T2, typename I>
 inline bool
-operator==(const allocator<T1> &, const allocator<T2> &) { return true; }
+operator==(const allocator<T1, I> &, const allocator<T2, I> &) { return true; }
 
-template<typename T>
+template<typename T, typename I>
 inline bool
-operator==(const allocator<T> &, const allocator<T> &) { return true; }
+operator==(const allocator<T, I> &, const allocator<T, I> &) { return true; }
 
 // All allocators are considered equal, as they merely use global new/delete.
-template<typename T1, typename T2>
+template<typename T1, typename T2, typename I>
 inline bool
-operator!=(const allocator<T1> &, const allocator<T2> &) { return false; }
+operator!=(const allocator<T1, I> &, const allocator<T2, I> &) { return false; }
 
-template<typename T>
+template<typename T, typename I>
 inline bool
-operator!=(const allocator<T> &, const allocator<T> &) { return false; }
+operator!=(const allocator<T, I> &, const allocator<T, I> &) { return false; }
 
-template<>
-class allocator<void> {
+template<class Instrument>
+class allocator<void, Instrument> {
 public:
     using size_type = size_t;
     using difference_type = ptrdiff_t;
@@ -96,7 +113,7 @@ public:
 
     template<class U>
     struct rebind {
-        using other = allocator<U>;
+        using other = allocator<U, Instrument>;
     };
 };
 
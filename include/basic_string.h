@@ -0,0 +1,401 @@
+#ifndef PGSTL_BASIC_STRING_H
+#define PGSTL_BASIC_STRING_H
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "allocator.h"
+#include "iterator.h"
+
+namespace pgstl {
+
+/**
+ * 带短字符串优化（SSO）的字符串
+ * 对象大小为三个指针（64 位下 24 字节）：长字符串模式下依次存放堆指针、长度和容量，
+ * 短字符串模式下整块内存用作字符缓冲区，最后一个字节记录长度。
+ * 对于 char 来说，不超过 22 个字符的字符串完全存放在对象内部，不申请堆内存，
+ * 放进 list 时也就完全存放在节点里
+ * @tparam CharT 字符类型，要求是平凡类型
+ * @tparam Allocator 分配器，通过 alloc_traits 重新绑定到 CharT
+ */
+template<class CharT, class Allocator = allocator<CharT>>
+class basic_string {
+public:
+    using value_type = CharT;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = CharT *;
+    using const_iterator = const CharT *;
+    using reverse_iterator = pgstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = pgstl::reverse_iterator<const_iterator>;
+    using reference = CharT &;
+    using const_reference = const CharT &;
+    using pointer = CharT *;
+    using const_pointer = const CharT *;
+    using allocator_type = typename alloc_traits<CharT, Allocator>::allocator_type;
+
+    static const size_type npos = size_type(-1);
+
+protected:
+    static const size_type rawSize = 3 * sizeof(void *);
+    // 长度字节的取值，短字符串的长度不会达到这个值
+    static const unsigned char longTag = 0x80;
+
+public:
+    // 短字符串模式下最多能存放的字符数（不含结尾的 0）
+    static const size_type shortCapacity = (rawSize - 1) / sizeof(CharT) - 1;
+
+protected:
+    bool isLong() const { return _impl._raw[rawSize - 1] == longTag; }
+
+    pointer shortData() { return reinterpret_cast<pointer>(_impl._raw); }
+    const_pointer shortData() const { return reinterpret_cast<const_pointer>(_impl._raw); }
+
+    // 长字符串模式下的字段通过 memcpy 读写，避免违反严格别名规则
+    pointer longData() const {
+        pointer p;
+        std::memcpy(&p, _impl._raw, sizeof(p));
+        return p;
+    }
+    size_type longSize() const {
+        size_type n;
+        std::memcpy(&n, _impl._raw + sizeof(pointer), sizeof(n));
+        return n;
+    }
+    size_type longCapacity() const {
+        // 容量只用了最后一个字(word)的低 sizeof(size_type) - 1 个字节，最后一个字节留给标记
+        size_type cap = 0;
+        for (size_type i = 0; i + 1 < sizeof(size_type); ++i)
+            cap |= size_type(_impl._raw[sizeof(pointer) + sizeof(size_type) + i]) << (8 * i);
+        return cap;
+    }
+    void setLong(pointer p, size_type n, size_type cap) {
+        std::memcpy(_impl._raw, &p, sizeof(p));
+        std::memcpy(_impl._raw + sizeof(pointer), &n, sizeof(n));
+        for (size_type i = 0; i + 1 < sizeof(size_type); ++i)
+            _impl._raw[sizeof(pointer) + sizeof(size_type) + i] = (unsigned char) (cap >> (8 * i));
+        _impl._raw[rawSize - 1] = longTag;
+    }
+    void setLongSize(size_type n) {
+        std::memcpy(_impl._raw + sizeof(pointer), &n, sizeof(n));
+    }
+    void setShortSize(size_type n) {
+        _impl._raw[rawSize - 1] = (unsigned char) n;
+    }
+
+    void setSize(size_type n) {
+        if (isLong())
+            setLongSize(n);
+        else
+            setShortSize(n);
+        data()[n] = CharT();
+    }
+
+    void initShort() {
+        setShortSize(0);
+        shortData()[0] = CharT();
+    }
+
+    void init(const CharT *s, size_type n) {
+        if (n <= shortCapacity) {
+            setShortSize(n);
+            copyChars(shortData(), s, n);
+            shortData()[n] = CharT();
+        } else {
+            pointer p = _impl.allocate(n + 1);
+            copyChars(p, s, n);
+            p[n] = CharT();
+            setLong(p, n, n);
+        }
+    }
+
+    void release() {
+        if (isLong())
+            _impl.deallocate(longData(), longCapacity() + 1);
+    }
+
+    static void copyChars(pointer dst, const_pointer src, size_type n) {
+        if (n)
+            std::memmove(dst, src, n * sizeof(CharT));
+    }
+
+    static size_type length(const CharT *s) {
+        size_type n = 0;
+        while (s[n] != CharT())
+            ++n;
+        return n;
+    }
+
+    // 与 std::char_traits 的语义一致：char 按 unsigned char 比较，直接交给 memcmp；
+    // 其他字符类型按字符的数值比较
+    static int compareChars(const char *a, const char *b, size_type n) {
+        return n ? std::memcmp(a, b, n) : 0;
+    }
+    template<class C>
+    static int compareChars(const C *a, const C *b, size_type n) {
+        for (size_type i = 0; i < n; ++i) {
+            if (a[i] < b[i])
+                return -1;
+            if (b[i] < a[i])
+                return 1;
+        }
+        return 0;
+    }
+
+    /**
+     * 把容量扩大到至少 n，按两倍增长，保留原有内容
+     */
+    void grow(size_type n) {
+        size_type cap = capacity();
+        if (n <= cap)
+            return;
+        if (n < 2 * cap)
+            n = 2 * cap;
+
+        size_type len = size();
+        pointer p = _impl.allocate(n + 1);
+        copyChars(p, data(), len + 1);
+        release();
+        setLong(p, len, n);
+    }
+
+public:
+    explicit basic_string(const allocator_type &alloc = allocator_type()) :
+            _impl(alloc) {
+        initShort();
+    }
+    basic_string(const CharT *s, const allocator_type &alloc = allocator_type()) :
+            _impl(alloc) {
+        init(s, length(s));
+    }
+    basic_string(const CharT *s, size_type n,
+                 const allocator_type &alloc = allocator_type()) :
+            _impl(alloc) {
+        init(s, n);
+    }
+    basic_string(size_type n, CharT c,
+                 const allocator_type &alloc = allocator_type()) :
+            _impl(alloc) {
+        initShort();
+        resize(n, c);
+    }
+    basic_string(const basic_string &x) : _impl(x._impl) {
+        init(x.data(), x.size());
+    }
+    basic_string(basic_string &&x) noexcept : _impl(x._impl) {
+        // 拷贝 _impl 时已经带走了 x 的全部内容（包括堆指针）
+        x.initShort();
+    }
+
+    ~basic_string() { release(); }
+
+    basic_string &operator=(const basic_string &x) {
+        if (this != &x)
+            assign(x.data(), x.size());
+        return *this;
+    }
+    basic_string &operator=(basic_string &&x) noexcept {
+        if (this != &x) {
+            release();
+            static_cast<allocator_type &>(_impl) = x._impl;
+            std::memcpy(_impl._raw, x._impl._raw, rawSize);
+            x.initShort();
+        }
+        return *this;
+    }
+    basic_string &operator=(const CharT *s) { return assign(s, length(s)); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    pointer data() { return isLong() ? longData() : shortData(); }
+    const_pointer data() const { return isLong() ? longData() : shortData(); }
+    const_pointer c_str() const { return data(); }
+
+    size_type size() const { return isLong() ? longSize() : _impl._raw[rawSize - 1]; }
+    size_type length() const { return size(); }
+    size_type capacity() const { return isLong() ? longCapacity() : shortCapacity; }
+    size_type max_size() const { return _impl.max_size() - 1; }
+    bool empty() const { return size() == 0; }
+
+    reference operator[](size_type n) { return data()[n]; }
+    const_reference operator[](size_type n) const { return data()[n]; }
+
+    reference front() { return *begin(); }
+    const_reference front() const { return *begin(); }
+    reference back() { return *(end() - 1); }
+    const_reference back() const { return *(end() - 1); }
+
+    void reserve(size_type n) { grow(n); }
+
+    void clear() { setSize(0); }
+
+    void resize(size_type n, CharT c = CharT()) {
+        size_type len = size();
+        if (n > len) {
+            grow(n);
+            pointer p = data();
+            for (size_type i = len; i < n; ++i)
+                p[i] = c;
+        }
+        setSize(n);
+    }
+
+    basic_string &assign(const CharT *s, size_type n) {
+        if (n > capacity()) {
+            // s 可能指向自身，先拷贝到新缓冲区再释放旧的
+            pointer p = _impl.allocate(n + 1);
+            copyChars(p, s, n);
+            release();
+            setLong(p, n, n);
+        } else {
+            copyChars(data(), s, n);
+        }
+        setSize(n);
+        return *this;
+    }
+
+    basic_string &append(const CharT *s, size_type n) {
+        size_type len = size();
+        if (len + n > capacity()) {
+            // s 可能指向自身，先拷贝到新缓冲区再释放旧的
+            size_type cap = len + n < 2 * capacity() ? 2 * capacity() : len + n;
+            pointer p = _impl.allocate(cap + 1);
+            copyChars(p, data(), len);
+            copyChars(p + len, s, n);
+            release();
+            setLong(p, len, cap);
+        } else {
+            copyChars(data() + len, s, n);
+        }
+        setSize(len + n);
+        return *this;
+    }
+    basic_string &append(const basic_string &x) { return append(x.data(), x.size()); }
+    basic_string &append(const CharT *s) { return append(s, length(s)); }
+
+    basic_string &operator+=(const basic_string &x) { return append(x); }
+    basic_string &operator+=(const CharT *s) { return append(s); }
+    basic_string &operator+=(CharT c) {
+        push_back(c);
+        return *this;
+    }
+
+    void push_back(CharT c) {
+        size_type len = size();
+        grow(len + 1);
+        data()[len] = c;
+        setSize(len + 1);
+    }
+    void pop_back() { setSize(size() - 1); }
+
+    int compare(const CharT *s, size_type n) const {
+        size_type len = size();
+        const_pointer p = data();
+        int r = compareChars(p, s, len < n ? len : n);
+        if (r != 0)
+            return r < 0 ? -1 : 1;
+        return len < n ? -1 : (n < len ? 1 : 0);
+    }
+    int compare(const basic_string &x) const { return compare(x.data(), x.size()); }
+    int compare(const CharT *s) const { return compare(s, length(s)); }
+
+    void swap(basic_string &x) {
+        unsigned char tmp[rawSize];
+        std::memcpy(tmp, _impl._raw, rawSize);
+        std::memcpy(_impl._raw, x._impl._raw, rawSize);
+        std::memcpy(x._impl._raw, tmp, rawSize);
+
+        allocator_type a = _impl;
+        static_cast<allocator_type &>(_impl) = x._impl;
+        static_cast<allocator_type &>(x._impl) = a;
+    }
+
+    allocator_type get_allocator() const {
+        return _impl;
+    }
+
+protected:
+    // 分配器通常是空类，作为基类存放可以不占用空间（空基类优化）
+    struct Impl : allocator_type {
+        explicit Impl(const allocator_type &a) : allocator_type(a) {}
+
+        alignas(void *) unsigned char _raw[rawSize];
+    };
+
+    Impl _impl;
+};
+
+template<class CharT, class Alloc>
+const typename basic_string<CharT, Alloc>::size_type basic_string<CharT, Alloc>::npos;
+
+template<class CharT, class Alloc>
+const typename basic_string<CharT, Alloc>::size_type basic_string<CharT, Alloc>::shortCapacity;
+
+template<class CharT, class Alloc>
+bool operator==(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs) {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template<class CharT, class Alloc>
+bool operator==(const basic_string<CharT, Alloc> &lhs, const CharT *rhs) {
+    return lhs.compare(rhs) == 0;
+}
+
+template<class CharT, class Alloc>
+bool operator!=(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs) {
+    return !(lhs == rhs);
+}
+
+template<class CharT, class Alloc>
+bool operator!=(const basic_string<CharT, Alloc> &lhs, const CharT *rhs) {
+    return !(lhs == rhs);
+}
+
+template<class CharT, class Alloc>
+bool operator<(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template<class CharT, class Alloc>
+bool operator<=(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs) {
+    return !(lhs > rhs);
+}
+
+template<class CharT, class Alloc>
+bool operator>(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs) {
+    return rhs < lhs;
+}
+
+template<class CharT, class Alloc>
+bool operator>=(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs) {
+    return !(lhs < rhs);
+}
+
+template<class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc> &lhs,
+                                     const basic_string<CharT, Alloc> &rhs) {
+    basic_string<CharT, Alloc> result(lhs);
+    result.append(rhs);
+    return result;
+}
+
+template<class CharT, class Alloc>
+void swap(basic_string<CharT, Alloc> &x, basic_string<CharT, Alloc> &y) {
+    x.swap(y);
+}
+
+using string = basic_string<char>;
+
+}
+
+#endif //PGSTL_BASIC_STRING_H
@@ -0,0 +1,326 @@
+#ifndef PGSTL_CHANNEL_H
+#define PGSTL_CHANNEL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "allocator.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>) && __has_include(<optional>)
+#define PGSTL_HAS_COROUTINE 1
+#include <coroutine>
+#include <optional>
+#endif
+#endif
+
+namespace pgstl {
+
+/**
+ * 有界的多生产者多消费者通道，底层是一个环形缓冲区
+ * 缓冲区满时 push 会阻塞生产者（背压），缓冲区空时 pop 会阻塞消费者
+ * 调用 close 之后 push 失败，pop 会把剩余元素取完后返回 false
+ * 在支持 C++20 协程的编译器上可以使用 co_await ch.pop() 异步地取元素
+ * @tparam T 元素类型
+ * @tparam Allocator 用于申请环形缓冲区的分配器
+ */
+template<class T, class Allocator = allocator<T>>
+class channel {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using allocator_type = typename alloc_traits<T, Allocator>::allocator_type;
+
+protected:
+    using LockType = std::unique_lock<std::mutex>;
+
+    T *slot(size_type i) { return _buffer + (_head + i) % _capacity; }
+
+    bool full() const { return _size == _capacity; }
+
+    // 以下函数都要求调用者已经持有 _mutex
+    void pushLocked(const T &x) {
+        allocator.construct(slot(_size), x);
+        ++_size;
+    }
+    void popLocked(T &x) {
+        T *p = slot(0);
+        x = std::move(*p);
+        allocator.destroy(p);
+        _head = (_head + 1) % _capacity;
+        --_size;
+    }
+#ifdef PGSTL_HAS_COROUTINE
+    // 直接移动构造到 optional 中，T 不需要默认构造函数
+    void popLocked(std::optional<T> &x) {
+        T *p = slot(0);
+        x.emplace(std::move(*p));
+        allocator.destroy(p);
+        _head = (_head + 1) % _capacity;
+        --_size;
+    }
+#endif
+
+public:
+    explicit channel(size_type capacity,
+                     const allocator_type &alloc = allocator_type()) :
+            allocator(alloc),
+            _buffer(nullptr),
+            _capacity(capacity ? capacity : 1),
+            _head(0),
+            _size(0),
+            _closed(false) {
+        _buffer = allocator.allocate(_capacity);
+    }
+
+    channel(const channel &) = delete;
+    channel &operator=(const channel &) = delete;
+
+    /**
+     * 销毁前先关闭通道，仍然挂起的协程会以 std::nullopt 恢复，不会被悬空
+     */
+    ~channel() {
+        close();
+        while (_size) {
+            allocator.destroy(slot(0));
+            _head = (_head + 1) % _capacity;
+            --_size;
+        }
+        allocator.deallocate(_buffer, _capacity);
+    }
+
+    size_type capacity() const { return _capacity; }
+    size_type size() const {
+        LockType lock(_mutex);
+        return _size;
+    }
+    bool empty() const { return size() == 0; }
+    bool closed() const {
+        LockType lock(_mutex);
+        return _closed;
+    }
+
+    /**
+     * 关闭通道，唤醒所有等待中的生产者和消费者
+     */
+    void close() {
+        LockType lock(_mutex);
+        _closed = true;
+#ifdef PGSTL_HAS_COROUTINE
+        PopAwaiter *waiters = _waiters;
+        _waiters = _waitersTail = nullptr;
+#endif
+        lock.unlock();
+        _notFull.notify_all();
+        _notEmpty.notify_all();
+#ifdef PGSTL_HAS_COROUTINE
+        while (waiters) {
+            PopAwaiter *next = waiters->_next;
+            waiters->_handle.resume();
+            waiters = next;
+        }
+#endif
+    }
+
+    /**
+     * 放入一个元素，缓冲区满时阻塞
+     * @return 通道已关闭时返回 false
+     */
+    bool push(const T &x) {
+        LockType lock(_mutex);
+        _notFull.wait(lock, [this] { return _closed || !full(); });
+        if (_closed)
+            return false;
+#ifdef PGSTL_HAS_COROUTINE
+        if (handOff(lock, x))
+            return true;
+#endif
+        pushLocked(x);
+        lock.unlock();
+        _notEmpty.notify_one();
+        return true;
+    }
+
+    bool try_push(const T &x) {
+        LockType lock(_mutex);
+        if (_closed || full())
+            return false;
+#ifdef PGSTL_HAS_COROUTINE
+        if (handOff(lock, x))
+            return true;
+#endif
+        pushLocked(x);
+        lock.unlock();
+        _notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * 批量放入 [first, last) 中的元素，每次拿到锁后尽可能多地写入，缓冲区满时阻塞
+     * @return 实际放入的元素个数，只有通道被关闭时才会小于 last - first
+     */
+    size_type push_n(const T *first, const T *last) {
+        size_type n = 0;
+        while (first != last) {
+            LockType lock(_mutex);
+            _notFull.wait(lock, [this] { return _closed || !full(); });
+            if (_closed)
+                break;
+#ifdef PGSTL_HAS_COROUTINE
+            if (handOff(lock, *first)) {
+                ++first;
+                ++n;
+                continue;
+            }
+#endif
+            for (; first != last && !full(); ++first, ++n)
+                pushLocked(*first);
+            lock.unlock();
+            _notEmpty.notify_all();
+        }
+        return n;
+    }
+
+    /**
+     * 取出一个元素，缓冲区空时阻塞
+     * @return 通道已关闭且没有剩余元素时返回 false
+     */
+    bool pop(T &x) {
+        LockType lock(_mutex);
+        _notEmpty.wait(lock, [this] { return _closed || _size != 0; });
+        if (_size == 0)
+            return false;
+        popLocked(x);
+        lock.unlock();
+        _notFull.notify_one();
+        return true;
+    }
+
+    bool try_pop(T &x) {
+        LockType lock(_mutex);
+        if (_size == 0)
+            return false;
+        popLocked(x);
+        lock.unlock();
+        _notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * 批量取出最多 n 个元素写入 out，至少有一个元素可取之前阻塞
+     * @return 实际取出的元素个数，通道已关闭且没有剩余元素时返回 0
+     */
+    size_type pop_n(T *out, size_type n) {
+        if (n == 0)
+            return 0;
+        LockType lock(_mutex);
+        _notEmpty.wait(lock, [this] { return _closed || _size != 0; });
+        size_type count = 0;
+        for (; count != n && _size != 0; ++count)
+            popLocked(out[count]);
+        lock.unlock();
+        if (count)
+            _notFull.notify_all();
+        return count;
+    }
+
+#ifdef PGSTL_HAS_COROUTINE
+    /**
+     * co_await ch.pop() 的等待体
+     * 缓冲区空时挂起协程，由之后的 push 把元素直接交给它并在生产者线程上恢复执行
+     * 恢复后得到 std::nullopt 表示通道已关闭
+     */
+    class PopAwaiter {
+    public:
+        explicit PopAwaiter(channel &ch) : _channel(ch) {}
+
+        bool await_ready() {
+            LockType lock(_channel._mutex);
+            if (_channel._size == 0)
+                return false;
+            _channel.popLocked(_value);
+            lock.unlock();
+            _channel._notFull.notify_one();
+            return true;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            LockType lock(_channel._mutex);
+            if (_channel._size != 0) {
+                _channel.popLocked(_value);
+                lock.unlock();
+                _channel._notFull.notify_one();
+                return false;
+            }
+            if (_channel._closed)
+                return false;
+
+            _handle = h;
+            _next = nullptr;
+            if (_channel._waitersTail)
+                _channel._waitersTail->_next = this;
+            else
+                _channel._waiters = this;
+            _channel._waitersTail = this;
+            return true;
+        }
+
+        std::optional<T> await_resume() { return std::move(_value); }
+
+    private:
+        friend class channel;
+
+        channel &_channel;
+        std::optional<T> _value;
+        std::coroutine_handle<> _handle;
+        PopAwaiter *_next = nullptr;
+    };
+
+    PopAwaiter pop() { return PopAwaiter(*this); }
+
+protected:
+    /**
+     * 有协程在等待时，把元素直接交给最早挂起的那个并恢复它
+     * 只有缓冲区为空时才会有等待者，所以这不会打乱元素顺序
+     * 要求调用者持有 lock，交付成功后 lock 会被释放
+     */
+    bool handOff(LockType &lock, const T &x) {
+        PopAwaiter *waiter = _waiters;
+        if (!waiter)
+            return false;
+        // 先拷贝再摘下等待者：拷贝抛出异常时等待者仍在队列中，之后还能被唤醒
+        waiter->_value.emplace(x);
+        _waiters = waiter->_next;
+        if (!_waiters)
+            _waitersTail = nullptr;
+        lock.unlock();
+        waiter->_handle.resume();
+        return true;
+    }
+#endif
+
+protected:
+    allocator_type allocator;
+    T *_buffer;
+    size_type _capacity;
+    size_type _head;
+    size_type _size;
+    bool _closed;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+
+#ifdef PGSTL_HAS_COROUTINE
+    PopAwaiter *_waiters = nullptr;
+    PopAwaiter *_waitersTail = nullptr;
+#endif
+};
+
+}
+
+#endif //PGSTL_CHANNEL_H
@@ -0,0 +1,478 @@
+#ifndef PGSTL_CONCURRENT_SKIP_LIST_H
+#define PGSTL_CONCURRENT_SKIP_LIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+#include "allocator.h"
+#include "list.h"
+
+namespace pgstl {
+
+/**
+ * 跳表节点
+ * 继承自 ListNode，最底层用 ListNodeBase 的 _next / _prev 串成一个带哨兵的环形双向链表，
+ * 因此可以直接用 ListConstIterator 有序遍历；上层的索引放在单独申请的 _tower 中
+ */
+template<class T>
+struct SkipListNode : ListNode<T> {
+    using Tower = std::atomic<SkipListNode *>;
+
+    Tower *_tower;
+    int _level;
+    std::atomic<bool> _marked;
+    std::atomic<bool> _fullyLinked;
+    std::atomic_flag _lock;
+
+    SkipListNode *next(int level) const {
+        return _tower[level].load(std::memory_order_acquire);
+    }
+    void setNext(int level, SkipListNode *x) {
+        _tower[level].store(x, std::memory_order_release);
+    }
+
+    void lock() {
+        while (_lock.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+    void unlock() { _lock.clear(std::memory_order_release); }
+};
+
+/**
+ * 支持多线程并发插入、查找和删除的有序集合，基于细粒度加锁的惰性跳表
+ * （Herlihy 等人的 lazy skip list）：查找不加锁，插入和删除只锁住被修改位置的前驱节点
+ *
+ * 被删除的节点可能仍在被其他线程的查找访问，摘链后先放进回收链表，用基于纪元（epoch）的回收
+ * 延迟释放：每个操作进入时登记当前纪元，所有登记在旧纪元的操作结束后纪元才会推进，
+ * 推进两次之后旧回收链表里的节点不可能再被访问，由推进纪元的线程释放。
+ * 某个线程长时间停在操作内部会阻止纪元推进，回收链表随之增长；没有并发访问时
+ * 可以调用 collect() 立即释放全部待回收的节点。
+ * begin() / end() 的有序遍历不登记纪元，只在没有并发写入时是安全的
+ * @tparam T 元素类型，要求支持 operator<
+ * @tparam Allocator 分配器，节点和索引塔都通过它申请
+ */
+template<class T, class Allocator = allocator<T>>
+class concurrent_skip_list {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = ListConstIterator<T>;
+    using const_iterator = ListConstIterator<T>;
+    using reference = const T &;
+    using const_reference = const T &;
+    using allocator_type = Allocator;
+
+    static const int maxLevel = 24;
+
+protected:
+    using Node = SkipListNode<T>;
+    using Tower = typename Node::Tower;
+    using NodeAllocator = typename Allocator::template rebind<Node>::other;
+    using TowerAllocator = typename Allocator::template rebind<Tower>::other;
+
+    // 登记纪元的计数器按线程分散到多个条带上，避免所有线程争抢同一个缓存行
+    static const int epochStripes = 16;
+    // 每个线程累计删除这么多个节点后尝试推进一次纪元
+    static const unsigned advanceInterval = 64;
+
+    // 每个条带独占一个缓存行；C++17 之前 new 出来的容器不保证 64 字节对齐，只会退化为伪共享
+    struct alignas(64) EpochStripe {
+        std::atomic<long> active[3];
+    };
+    static_assert(sizeof(EpochStripe) == 64, "an epoch stripe should fill exactly one cache line");
+
+    /**
+     * 在当前纪元登记一个正在进行的操作，析构时注销
+     * 登记后要重新检查纪元：读到旧纪元时纪元可能已经推进，此时登记无效，需要重来
+     */
+    class EpochGuard {
+    public:
+        explicit EpochGuard(const concurrent_skip_list &l) : _stripe(l._stripes[stripeIndex()]) {
+            for (;;) {
+                _epoch = l._epoch.load();
+                _stripe.active[_epoch % 3].fetch_add(1);
+                if (l._epoch.load() == _epoch)
+                    break;
+                _stripe.active[_epoch % 3].fetch_sub(1);
+            }
+        }
+        ~EpochGuard() { _stripe.active[_epoch % 3].fetch_sub(1, std::memory_order_release); }
+
+        EpochGuard(const EpochGuard &) = delete;
+        EpochGuard &operator=(const EpochGuard &) = delete;
+
+    private:
+        EpochStripe &_stripe;
+        size_t _epoch;
+    };
+
+    static int stripeIndex() {
+        static std::atomic<unsigned> next(0);
+        static thread_local int index = int(next.fetch_add(1, std::memory_order_relaxed) % epochStripes);
+        return index;
+    }
+
+    /**
+     * 申请节点并初始化除 _data 以外的字段，_data 由调用者负责构造
+     */
+    Node *createNode(int level) {
+        Node *p = nodeAllocator.allocate(1);
+        try {
+            p->_tower = towerAllocator.allocate(level + 1);
+        } catch (...) {
+            nodeAllocator.deallocate(p, 1);
+            throw;
+        }
+        for (int i = 0; i <= level; ++i)
+            ::new(static_cast<void *>(p->_tower + i)) Tower(nullptr);
+        p->_level = level;
+        ::new(static_cast<void *>(&p->_marked)) std::atomic<bool>(false);
+        ::new(static_cast<void *>(&p->_fullyLinked)) std::atomic<bool>(false);
+        ::new(static_cast<void *>(&p->_lock)) std::atomic_flag();
+        p->_lock.clear();
+        return p;
+    }
+    void deleteNode(Node *p) {
+        towerAllocator.deallocate(p->_tower, p->_level + 1);
+        nodeAllocator.deallocate(p, 1);
+    }
+    void destroyNode(Node *p) {
+        allocator.destroy(&p->_data);
+        deleteNode(p);
+    }
+
+    // 元素的构造函数抛出异常时要先把节点还回去，避免内存泄漏
+    Node *constructNode(int level, const T &x) {
+        Node *p = createNode(level);
+        try {
+            allocator.construct(&p->_data, x);
+        } catch (...) {
+            deleteNode(p);
+            throw;
+        }
+        return p;
+    }
+
+    static int randomLevel() {
+        // 每个线程一个 xorshift 随机数发生器，每层晋升的概率为 1/2
+        static thread_local unsigned long long seed =
+                0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&seed);
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        int level = 0;
+        unsigned long long bits = seed;
+        while ((bits & 1) && level < maxLevel - 1) {
+            ++level;
+            bits >>= 1;
+        }
+        return level;
+    }
+
+    /**
+     * 在每一层上找到 x 的前驱和后继（后继为 nullptr 表示正无穷）
+     * @return x 所在的最高层，不存在时返回 -1
+     */
+    int find(const T &x, Node **preds, Node **succs) const {
+        int found = -1;
+        Node *pred = _head;
+        for (int level = maxLevel - 1; level >= 0; --level) {
+            Node *cur = pred->next(level);
+            while (cur && cur->_data < x) {
+                pred = cur;
+                cur = pred->next(level);
+            }
+            if (found == -1 && cur && !(x < cur->_data))
+                found = level;
+            preds[level] = pred;
+            succs[level] = cur;
+        }
+        return found;
+    }
+
+    static void unlockPreds(Node **preds, int highest) {
+        Node *prev = nullptr;
+        for (int level = 0; level <= highest; ++level) {
+            if (preds[level] != prev)
+                preds[level]->unlock();
+            prev = preds[level];
+        }
+    }
+
+    /**
+     * 把已经摘链的节点放进当前纪元的回收链表，必须在调用者的 EpochGuard 有效期间调用：
+     * 调用者自己的登记保证纪元在此期间最多推进一次，不会提前释放这个节点
+     */
+    void retire(Node *p) {
+        std::atomic<Node *> &retired = _retired[_epoch.load() % 3];
+        // 节点已经从最底层摘下，_next 可以复用为回收链表的指针
+        Node *head = retired.load(std::memory_order_relaxed);
+        do {
+            p->_next = head;
+        } while (!retired.compare_exchange_weak(head, p, std::memory_order_release,
+                                                std::memory_order_relaxed));
+
+        static thread_local unsigned retiredCount = 0;
+        if (++retiredCount % advanceInterval == 0)
+            tryAdvance();
+    }
+
+    /**
+     * 纪元 e 推进到 e + 1 的条件是没有操作还登记在 e - 1，
+     * 此时 e - 1 期间摘链的节点已经不可能被任何操作访问，可以释放
+     */
+    void tryAdvance() {
+        size_t e = _epoch.load();
+        size_t old = (e + 2) % 3;
+        for (int i = 0; i < epochStripes; ++i)
+            if (_stripes[i].active[old].load() != 0)
+                return;
+        if (!_epoch.compare_exchange_strong(e, e + 1))
+            return;
+        freeRetired(_retired[old].exchange(nullptr, std::memory_order_acquire));
+    }
+
+    void freeRetired(Node *p) {
+        while (p) {
+            Node *next = static_cast<Node *>(p->_next);
+            destroyNode(p);
+            p = next;
+        }
+    }
+
+public:
+    explicit concurrent_skip_list(const allocator_type &alloc = allocator_type()) :
+            _head(nullptr), _epoch(0), _size(0), allocator(alloc) {
+        for (int i = 0; i < 3; ++i)
+            _retired[i].store(nullptr, std::memory_order_relaxed);
+        for (int i = 0; i < epochStripes; ++i)
+            for (int j = 0; j < 3; ++j)
+                _stripes[i].active[j].store(0, std::memory_order_relaxed);
+        _head = createNode(maxLevel - 1);
+        _head->_next = _head;
+        _head->_prev = _head;
+        _head->_fullyLinked.store(true);
+    }
+
+    concurrent_skip_list(const concurrent_skip_list &) = delete;
+    concurrent_skip_list &operator=(const concurrent_skip_list &) = delete;
+
+    ~concurrent_skip_list() {
+        clear();
+        deleteNode(_head);
+    }
+
+    const_iterator begin() const { return _head->_next; }
+    const_iterator end() const { return static_cast<const ListNodeBase *>(_head); }
+
+    size_type size() const { return _size.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * 插入 x，可以被多个线程同时调用
+     * @return x 已经存在时返回 false
+     */
+    bool insert(const T &x) {
+        EpochGuard guard(*this);
+        int topLevel = randomLevel();
+        Node *preds[maxLevel];
+        Node *succs[maxLevel];
+        Node *node = nullptr;
+
+        for (;;) {
+            int found = find(x, preds, succs);
+            if (found != -1) {
+                Node *existing = succs[found];
+                if (!existing->_marked.load(std::memory_order_acquire)) {
+                    while (!existing->_fullyLinked.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    // 节点还没有链入，其他线程看不到它，可以直接释放
+                    if (node)
+                        destroyNode(node);
+                    return false;
+                }
+                // 找到的是正在被删除的节点，等它摘链后重试
+                continue;
+            }
+
+            // 加锁之前申请并构造节点，持有锁期间不会再抛出异常；重试时复用同一个节点
+            if (!node)
+                node = constructNode(topLevel, x);
+
+            int highest = -1;
+            bool valid = true;
+            Node *prev = nullptr;
+            for (int level = 0; valid && level <= topLevel; ++level) {
+                Node *pred = preds[level];
+                Node *succ = succs[level];
+                if (pred != prev) {
+                    pred->lock();
+                    prev = pred;
+                }
+                highest = level;
+                valid = !pred->_marked.load(std::memory_order_acquire) &&
+                        (!succ || !succ->_marked.load(std::memory_order_acquire)) &&
+                        pred->next(level) == succ;
+            }
+            if (!valid) {
+                unlockPreds(preds, highest);
+                continue;
+            }
+
+            for (int level = 0; level <= topLevel; ++level)
+                node->setNext(level, succs[level]);
+
+            // 最底层的双向链接受 preds[0] 的锁保护
+            ListNodeBase *after = succs[0] ? static_cast<ListNodeBase *>(succs[0]) : _head;
+            node->_prev = preds[0];
+            node->_next = after;
+            preds[0]->_next = node;
+            after->_prev = node;
+
+            for (int level = 0; level <= topLevel; ++level)
+                preds[level]->setNext(level, node);
+
+            node->_fullyLinked.store(true, std::memory_order_release);
+            _size.fetch_add(1, std::memory_order_relaxed);
+            unlockPreds(preds, highest);
+            return true;
+        }
+    }
+
+    /**
+     * 删除 x，可以被多个线程同时调用
+     * @return x 不存在时返回 false
+     */
+    bool erase(const T &x) {
+        EpochGuard guard(*this);
+        Node *victim = nullptr;
+        bool isMarked = false;
+        int topLevel = -1;
+        Node *preds[maxLevel];
+        Node *succs[maxLevel];
+
+        for (;;) {
+            int found = find(x, preds, succs);
+            if (found != -1)
+                victim = succs[found];
+
+            if (!isMarked) {
+                if (found == -1 ||
+                    !victim->_fullyLinked.load(std::memory_order_acquire) ||
+                    victim->_level != found ||
+                    victim->_marked.load(std::memory_order_acquire))
+                    return false;
+
+                topLevel = victim->_level;
+                victim->lock();
+                if (victim->_marked.load(std::memory_order_acquire)) {
+                    victim->unlock();
+                    return false;
+                }
+                victim->_marked.store(true, std::memory_order_release);
+                isMarked = true;
+            }
+
+            int highest = -1;
+            bool valid = true;
+            Node *prev = nullptr;
+            for (int level = 0; valid && level <= topLevel; ++level) {
+                Node *pred = preds[level];
+                if (pred != prev) {
+                    pred->lock();
+                    prev = pred;
+                }
+                highest = level;
+                valid = !pred->_marked.load(std::memory_order_acquire) &&
+                        pred->next(level) == victim;
+            }
+            if (!valid) {
+                unlockPreds(preds, highest);
+                continue;
+            }
+
+            for (int level = topLevel; level >= 0; --level)
+                preds[level]->setNext(level, victim->next(level));
+
+            victim->_prev->_next = victim->_next;
+            victim->_next->_prev = victim->_prev;
+
+            victim->unlock();
+            _size.fetch_sub(1, std::memory_order_relaxed);
+            unlockPreds(preds, highest);
+            retire(victim);
+            return true;
+        }
+    }
+
+    /**
+     * 查找 x，不加锁
+     */
+    bool contains(const T &x) const {
+        EpochGuard guard(*this);
+        Node *preds[maxLevel];
+        Node *succs[maxLevel];
+        int found = find(x, preds, succs);
+        return found != -1 &&
+               succs[found]->_fullyLinked.load(std::memory_order_acquire) &&
+               !succs[found]->_marked.load(std::memory_order_acquire);
+    }
+    size_type count(const T &x) const { return contains(x) ? 1 : 0; }
+
+    /**
+     * 立即释放所有已删除但还在等待纪元推进的节点，调用时不能有其他线程在访问该容器
+     */
+    void collect() {
+        for (int i = 0; i < 3; ++i)
+            freeRetired(_retired[i].exchange(nullptr, std::memory_order_acquire));
+    }
+
+    /**
+     * 删除全部元素并回收已删除节点的内存，调用时不能有其他线程在访问该容器
+     */
+    void clear() {
+        ListNodeBase *cur = _head->_next;
+        while (cur != _head) {
+            Node *tmp = static_cast<Node *>(cur);
+            cur = cur->_next;
+            destroyNode(tmp);
+        }
+        _head->_next = _head;
+        _head->_prev = _head;
+        for (int level = 0; level < maxLevel; ++level)
+            _head->setNext(level, nullptr);
+        _size.store(0, std::memory_order_relaxed);
+        collect();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator;
+    }
+
+protected:
+    Node *_head;
+    std::atomic<size_t> _epoch;
+    std::atomic<Node *> _retired[3];
+    mutable EpochStripe _stripes[epochStripes];
+    std::atomic<size_type> _size;
+    NodeAllocator nodeAllocator;
+    TowerAllocator towerAllocator;
+    allocator_type allocator;
+};
+
+template<class T, class Allocator>
+const int concurrent_skip_list<T, Allocator>::maxLevel;
+
+template<class T, class Allocator>
+const int concurrent_skip_list<T, Allocator>::epochStripes;
+
+template<class T, class Allocator>
+const unsigned concurrent_skip_list<T, Allocator>::advanceInterval;
+
+}
+
+#endif //PGSTL_CONCURRENT_SKIP_LIST_H
@@ -0,0 +1,14 @@
+#ifndef PGSTL_CONFIG_H
+#define PGSTL_CONFIG_H
+
+// C++20 起可以在常量表达式中用 std::construct_at / std::destroy_at 构造和析构对象，
+// 这时固定容量容器改用 union 存放元素，整个接口都可以在 constexpr 中使用；
+// 更早的标准下仍然使用 aligned_storage，PGSTL_CONSTEXPR20 展开为空
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+#define PGSTL_CONSTEXPR_CONTAINERS 1
+#define PGSTL_CONSTEXPR20 constexpr
+#else
+#define PGSTL_CONSTEXPR20
+#endif
+
+#endif //PGSTL_CONFIG_H
@@ -0,0 +1,18 @@
+#ifndef PGSTL_FUNCTIONAL_H
+#define PGSTL_FUNCTIONAL_H
+
+namespace pgstl {
+
+template<class T>
+struct less {
+    bool operator()(const T &x, const T &y) const { return x < y; }
+};
+
+template<class T>
+struct greater {
+    bool operator()(const T &x, const T &y) const { return y < x; }
+};
+
+}
+
+#endif //PGSTL_FUNCTIONAL_H
@@ -0,0 +1,236 @@
+#ifndef PGSTL_INSTRUMENT_H
+#define PGSTL_INSTRUMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace pgstl {
+
+/**
+ * 可以被统计的热点操作
+ */
+enum instrument_event {
+    list_sort,
+    list_merge,
+    list_unique,
+    list_remove,
+    list_reverse,
+    list_splice,
+    list_clear,
+    allocator_allocate,
+    allocator_deallocate,
+    instrument_event_count
+};
+
+inline const char *instrument_event_name(instrument_event e) {
+    static const char *const names[instrument_event_count] = {
+            "list::sort",
+            "list::merge",
+            "list::unique",
+            "list::remove",
+            "list::reverse",
+            "list::splice",
+            "list::clear",
+            "allocator::allocate",
+            "allocator::deallocate",
+    };
+    return names[e];
+}
+
+/**
+ * 默认的插桩策略：所有钩子都是空的内联函数，编译后不留下任何代码
+ */
+struct null_instrument {
+    struct scope {
+        explicit scope(instrument_event) {}
+    };
+
+    template<class Container>
+    static void record_length(const scope &, const Container &) {}
+    static void record_length(const scope &, size_t) {}
+};
+
+/**
+ * 单个事件的统计值，多线程下用原子变量累加
+ */
+struct instrument_counter {
+    std::atomic<unsigned long long> calls;
+    std::atomic<unsigned long long> total_ns;
+    std::atomic<unsigned long long> max_ns;
+    std::atomic<unsigned long long> total_length;
+    std::atomic<unsigned long long> max_length;
+
+    static void update_max(std::atomic<unsigned long long> &m, unsigned long long v) {
+        unsigned long long cur = m.load(std::memory_order_relaxed);
+        while (v > cur && !m.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+};
+
+/**
+ * 统计数据的全局存储，进程退出时如果有统计数据，按环境变量 PGSTL_INSTRUMENT_REPORT
+ * 输出报告到 stderr，取值为 text（默认）、json 或 off
+ * 报告函数是模板，接受 std::ostream 或任何支持同样 << 操作的输出对象，
+ * 这个头文件因此不需要引入 <iostream>
+ */
+class instrument_registry {
+public:
+    static instrument_registry &instance() {
+        static instrument_registry registry;
+        return registry;
+    }
+
+    instrument_counter &counter(instrument_event e) { return _counters[e]; }
+
+    template<class Ostream>
+    void report(Ostream &os) const {
+        os << "pgstl instrumentation report\n";
+        for (int i = 0; i < instrument_event_count; ++i) {
+            const instrument_counter &c = _counters[i];
+            unsigned long long calls = c.calls.load();
+            if (calls == 0)
+                continue;
+            os << "  " << instrument_event_name(static_cast<instrument_event>(i))
+               << ": calls=" << calls
+               << " total_ns=" << c.total_ns.load()
+               << " avg_ns=" << c.total_ns.load() / calls
+               << " max_ns=" << c.max_ns.load()
+               << " avg_length=" << c.total_length.load() / calls
+               << " max_length=" << c.max_length.load() << '\n';
+        }
+    }
+
+    template<class Ostream>
+    void report_json(Ostream &os) const {
+        os << '{';
+        bool first = true;
+        for (int i = 0; i < instrument_event_count; ++i) {
+            const instrument_counter &c = _counters[i];
+            if (!first)
+                os << ',';
+            first = false;
+            os << '"' << instrument_event_name(static_cast<instrument_event>(i)) << "\":{"
+               << "\"calls\":" << c.calls.load()
+               << ",\"total_ns\":" << c.total_ns.load()
+               << ",\"max_ns\":" << c.max_ns.load()
+               << ",\"total_length\":" << c.total_length.load()
+               << ",\"max_length\":" << c.max_length.load() << '}';
+        }
+        os << "}\n";
+    }
+
+    void reset() {
+        for (int i = 0; i < instrument_event_count; ++i) {
+            _counters[i].calls = 0;
+            _counters[i].total_ns = 0;
+            _counters[i].max_ns = 0;
+            _counters[i].total_length = 0;
+            _counters[i].max_length = 0;
+        }
+    }
+
+private:
+    // 进程退出时的报告直接写到 stderr
+    struct FileWriter {
+        std::FILE *file;
+
+        FileWriter &operator<<(const char *s) {
+            std::fputs(s, file);
+            return *this;
+        }
+        FileWriter &operator<<(char c) {
+            std::fputc(c, file);
+            return *this;
+        }
+        FileWriter &operator<<(unsigned long long v) {
+            std::fprintf(file, "%llu", v);
+            return *this;
+        }
+    };
+
+    instrument_registry() { reset(); }
+
+    ~instrument_registry() {
+        bool any = false;
+        for (int i = 0; i < instrument_event_count; ++i)
+            any = any || _counters[i].calls.load() != 0;
+        if (!any)
+            return;
+
+        const char *format = std::getenv("PGSTL_INSTRUMENT_REPORT");
+        if (format && std::strcmp(format, "off") == 0)
+            return;
+        FileWriter out = {stderr};
+        if (format && std::strcmp(format, "json") == 0)
+            report_json(out);
+        else
+            report(out);
+    }
+
+    instrument_counter _counters[instrument_event_count];
+};
+
+/**
+ * 计数插桩策略：统计每个事件的调用次数、耗时以及操作时的容器长度
+ */
+struct counting_instrument {
+    class scope {
+    public:
+        explicit scope(instrument_event e) :
+                _counter(instrument_registry::instance().counter(e)),
+                _start(std::chrono::steady_clock::now()) {}
+
+        ~scope() {
+            unsigned long long ns = static_cast<unsigned long long>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - _start).count());
+            _counter.calls.fetch_add(1, std::memory_order_relaxed);
+            _counter.total_ns.fetch_add(ns, std::memory_order_relaxed);
+            instrument_counter::update_max(_counter.max_ns, ns);
+        }
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+    private:
+        friend struct counting_instrument;
+
+        instrument_counter &_counter;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    template<class Container>
+    static void record_length(const scope &s, const Container &c) {
+        record_length(s, static_cast<size_t>(c.size()));
+    }
+    static void record_length(const scope &s, size_t n) {
+        s._counter.total_length.fetch_add(n, std::memory_order_relaxed);
+        instrument_counter::update_max(s._counter.max_length, n);
+    }
+};
+
+#ifdef PGSTL_ENABLE_INSTRUMENTATION
+using default_instrument = counting_instrument;
+#else
+using default_instrument = null_instrument;
+#endif
+
+/**
+ * 随时输出当前的统计报告（未开启插桩时所有计数都是 0）
+ */
+template<class Ostream>
+void instrument_report(Ostream &os) {
+    instrument_registry::instance().report(os);
+}
+
+template<class Ostream>
+void instrument_report_json(Ostream &os) {
+    instrument_registry::instance().report_json(os);
+}
+
+}
+
+#endif //PGSTL_INSTRUMENT_H
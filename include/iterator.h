@@ -1,6 +1,8 @@
 #ifndef PGSTL_ITERATOR_H
 #define PGSTL_ITERATOR_H
 
+#include "config.h"
+
 namespace pgstl {
 
 struct input_iterator_tag {
@@ -212,7 +214,7 @@ distance(RandomAccessIterator first, RandomAccessIterator last,
 }
 
 template<class InputIterator1, class InputIterator2>
-inline bool lexicographical_compare(
+inline PGSTL_CONSTEXPR20 bool lexicographical_compare(
         InputIterator1 first1, InputIterator1 last1,
         InputIterator2 first2, InputIterator2 last2) {
     for (; first1 != last1 && first2 != last2; ++first1, ++first2)
@@ -1,6 +1,9 @@
 #ifndef PGSTL_LIST_H
 #define PGSTL_LIST_H
 
+#include <type_traits>
+#include <utility>
+
 #include "allocator.h"
 #include "iterator.h"
 
@@ -122,7 +125,13 @@ struct ListConstIterator {
     }
 };
 
-template<class T, class Allocator = allocator<T>>
+/**
+ * 双向链表
+ * @tparam T 元素类型
+ * @tparam Allocator 分配器
+ * @tparam Instrument 插桩策略，用于统计 sort / merge / unique 等热点操作，默认不产生任何代码
+ */
+template<class T, class Allocator = allocator<T>, class Instrument = default_instrument>
 class list {
 public:
     using value_type = T;
@@ -146,22 +155,59 @@ protected:
         nodeAllocator.deallocate(static_cast<ListNode<T> *>(p), 1);
     }
 
+    // 元素的构造函数抛出异常时要先把节点还回去，避免内存泄漏
     ListNodeBase *constructNode(const T &x) {
         ListNodeBase *p = createNode();
-        allocator.construct(&(static_cast<ListNode<T> *>(p)->_data), x);
+        try {
+            allocator.construct(&(static_cast<ListNode<T> *>(p)->_data), x);
+        } catch (...) {
+            deleteNode(p);
+            throw;
+        }
+        return p;
+    }
+    ListNodeBase *constructNode(T &&x) {
+        ListNodeBase *p = createNode();
+        try {
+            allocator.construct(&(static_cast<ListNode<T> *>(p)->_data), std::move(x));
+        } catch (...) {
+            deleteNode(p);
+            throw;
+        }
         return p;
     }
     void destroyNode(ListNodeBase *p) {
-        allocator.destroy(&(static_cast<ListNode<T> *>(p)->_data));
+        destroyData(p, std::is_trivially_destructible<T>());
         deleteNode(p);
     }
 
+    // 平凡析构的类型不需要调用析构函数，直接释放节点即可
+    void destroyData(ListNodeBase *, std::true_type) {}
+    void destroyData(ListNodeBase *p, std::false_type) {
+        allocator.destroy(&(static_cast<ListNode<T> *>(p)->_data));
+    }
+
     void initList() {
         _node = createNode();
         _node->_next = _node;
         _node->_prev = _node;
     }
 
+    /**
+     * 构造函数中途抛出异常时析构函数不会被调用，需要手动释放已经申请的节点
+     */
+    template<class InputIterator>
+    void initList(InputIterator first, InputIterator last) {
+        initList();
+        try {
+            assign(first, last);
+        } catch (...) {
+            clear();
+            deleteNode(_node);
+            throw;
+        }
+    }
+
     void transfer(iterator position, iterator first, iterator last) {
         if (position != last) {
             last._node->_prev->_next = position._node;
@@ -186,34 +232,39 @@ public:
             _node(nullptr),
             allocator(alloc) {
         initList();
-        assign(n, val);
+        try {
+            assign(n, val);
+        } catch (...) {
+            clear();
+            deleteNode(_node);
+            throw;
+        }
     }
     list(const T *first, const T *last,
          const allocator_type &alloc = allocator_type()) :
             _node(nullptr),
             allocator(alloc) {
-        initList();
-        assign(first, last);
+        initList(first, last);
     }
     list(const_iterator first, const_iterator last,
          const allocator_type &alloc = allocator_type()) :
             _node(nullptr), allocator(alloc) {
-        initList();
-        assign(first, last);
+        initList(first, last);
+    }
+    list(const list &x) : _node(nullptr), allocator(x.allocator) {
+        initList(x.begin(), x.end());
     }
-    list(const list &x) : _node(x._node), allocator(x.allocator) {}
 
     ~list() {
         clear();
         deleteNode(_node);
     }
 
+    // 先在临时链表中拷贝好全部元素再交换，拷贝失败时 *this 保持不变（强异常安全）
     list &operator=(const list &x) {
         if (this != &x) {
-            clear();
-            for (const_iterator iter = x.begin(); iter != x.end(); ++iter) {
-                push_back(*iter);
-            }
+            list tmp(x.begin(), x.end(), allocator);
+            ListNodeBase::swap(*_node, *tmp._node);
         }
         return *this;
     }
@@ -231,10 +282,10 @@ public:
 
     bool empty() const { return _node->_next == _node; }
     size_type size() const {
-        return distance(begin(), end());
+        return pgstl::distance(begin(), end());
     }
     size_type max_size() const {
-        nodeAllocator.max_size();
+        return nodeAllocator.max_size();
     }
 
     reference front() { return *begin(); }
@@ -245,12 +296,12 @@ public:
         return *tmp;
     }
     const_reference back() const {
-        iterator tmp = end();
+        const_iterator tmp = end();
         --tmp;
         return *tmp;
     }
 
-    void assign(iterator first, iterator last) {
+    void assign(const_iterator first, const_iterator last) {
         clear();
         for (; first != last; ++first)
             push_back(*first);
@@ -275,6 +326,15 @@ public:
         position._node->_prev = tmp;
         return tmp;
     }
+    iterator insert(iterator position, T &&x) {
+        ListNodeBase *tmp = constructNode(std::move(x));
+        tmp->_next = position._node;
+        tmp->_prev = position._node->_prev;
+
+        position._node->_prev->_next = tmp;
+        position._node->_prev = tmp;
+        return tmp;
+    }
     void insert(iterator position, size_type n, const value_type &val) {
         list tmp(n, val, allocator);
         splice(position, tmp);
@@ -286,6 +346,8 @@ public:
     }
     void push_front(const T &x) { insert(begin(), x); }
     void push_back(const T &x) { insert(end(), x); }
+    void push_front(T &&x) { insert(begin(), std::move(x)); }
+    void push_back(T &&x) { insert(end(), std::move(x)); }
 
     iterator erase(iterator position) {
         ListNodeBase *next_node = position._node->_next;
@@ -320,6 +382,7 @@ public:
     }
 
     void clear() {
+        typename Instrument::scope probe(list_clear);
         ListNodeBase *cur = _node->_next;
 
         while (cur != _node) {
@@ -333,8 +396,10 @@ public:
     }
 
     void remove(const T &value) {
+        typename Instrument::scope probe(list_remove);
         iterator first = begin();
         iterator last = end();
+        size_type n = 0;
 
         while (first != last) {
             iterator next = first;
@@ -342,15 +407,19 @@ public:
             if (*first == value)
                 erase(first);
             first = next;
+            ++n;
         }
+        Instrument::record_length(probe, n);
     }
 
     void unique() {
+        typename Instrument::scope probe(list_unique);
         if (empty()) return;
 
         iterator first = begin();
         iterator last = end();
         iterator next = first;
+        size_type n = 1;
 
         while (++next != last) {
             if (*first == *next)
@@ -358,15 +427,19 @@ public:
             else
                 first = next;
             next = first;
+            ++n;
         }
+        Instrument::record_length(probe, n);
     }
 
     void splice(iterator position, list &x) {
+        typename Instrument::scope probe(list_splice);
         if (!x.empty())
             transfer(position, x.begin(), x.end());
     }
 
     void splice(iterator position, list &x, iterator i) {
+        typename Instrument::scope probe(list_splice);
         iterator j = i;
         ++j;
         if (position == i || position == j)
@@ -375,15 +448,19 @@ public:
     }
 
     void splice(iterator position, list &x, iterator first, iterator last) {
+        typename Instrument::scope probe(list_splice);
         if (first != last)
             transfer(position, first, last);
     }
 
     void merge(list &x) {
+        typename Instrument::scope probe(list_merge);
         iterator first1 = begin();
         iterator last1 = end();
         iterator first2 = x.begin();
         iterator last2 = x.end();
+        // 统计实际比较过的元素个数，剩余的尾部整段转移，不需要遍历
+        size_type n = 0;
 
         while (first1 != last1 && first2 != last2) {
             if (*first2 < *first1) {
@@ -393,34 +470,47 @@ public:
             } else {
                 ++first1;
             }
+            ++n;
         }
         if (first2 != last2)
             transfer(last1, first2, last2);
+        Instrument::record_length(probe, n);
     }
 
     void reverse() {
+        typename Instrument::scope probe(list_reverse);
         if (empty() || _node->_next->_next == _node)
             return;
         iterator first = begin();
         ++first;
+        size_type n = 1;
         while (first != end()) {
             iterator old = first;
             ++first;
             transfer(begin(), old, first);
+            ++n;
         }
+        Instrument::record_length(probe, n);
     }
 
     void sort() {
+        typename Instrument::scope probe(list_sort);
         if (empty() || _node->_next->_next == _node)
             return;
 
-        list carry;
-        list counter[64];
+        // 临时链表不插桩，它们内部的 merge / splice 不应计入统计
+        using ScratchList = list<T, Allocator, null_instrument>;
+        ScratchList carry;
+        ScratchList counter[64];
 
         int fill = 0;
+        size_type n = 0;
 
         while (!empty()) {
-            carry.splice(carry.begin(), *this, begin());
+            iterator first = begin();
+            iterator next = first;
+            carry.transfer(carry.begin(), first, ++next);
+            ++n;
             int i = 0;
             while (i < fill && !counter[i].empty()) {
                 counter[i].merge(carry);
@@ -433,7 +523,9 @@ public:
 
         for (int i = 1; i < fill; ++i)
             counter[i].merge(counter[i - 1]);
-        swap(counter[fill - 1]);
+        // 节点始终由 *this 的分配器申请，直接交换哨兵节点把结果换回来
+        ListNodeBase::swap(*_node, *counter[fill - 1]._node);
+        Instrument::record_length(probe, n);
     }
 
     void swap(list &x) {
@@ -451,13 +543,16 @@ public:
     }
 
 protected:
+    // sort 使用不同插桩策略的临时链表，需要访问它们的节点
+    template<class, class, class> friend class list;
+
     ListNodeBase *_node;
     NodeAllocator nodeAllocator;
     allocator_type allocator;
 };
 
-template<class T, class Alloc>
-bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+template<class T, class Alloc, class I>
+bool operator==(const list<T, Alloc, I> &lhs, const list<T, Alloc, I> &rhs) {
     auto end1 = lhs.end();
     auto end2 = rhs.end();
 
@@ -470,35 +565,35 @@ bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     return i1 == end1 && i2 == end2;
 }
 
-template<class T, class Alloc>
-bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+template<class T, class Alloc, class I>
+bool operator!=(const list<T, Alloc, I> &lhs, const list<T, Alloc, I> &rhs) {
     return !(lhs == rhs);
 }
 
-template<class T, class Alloc>
-bool operator<(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+template<class T, class Alloc, class I>
+bool operator<(const list<T, Alloc, I> &lhs, const list<T, Alloc, I> &rhs) {
     return lexicographical_compare(
             lhs.begin(), lhs.end(),
             rhs.begin(), rhs.end());
 }
 
-template<class T, class Alloc>
-bool operator<=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+template<class T, class Alloc, class I>
+bool operator<=(const list<T, Alloc, I> &lhs, const list<T, Alloc, I> &rhs) {
     return !(lhs > rhs);
 }
 
-template<class T, class Alloc>
-bool operator>(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+template<class T, class Alloc, class I>
+bool operator>(const list<T, Alloc, I> &lhs, const list<T, Alloc, I> &rhs) {
     return rhs < lhs;
 }
 
-template<class T, class Alloc>
-bool operator>=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
+template<class T, class Alloc, class I>
+bool operator>=(const list<T, Alloc, I> &lhs, const list<T, Alloc, I> &rhs) {
     return !(lhs < rhs);
 }
 
-template<class T, class Alloc>
-void swap(list<T, Alloc> &x, list<T, Alloc> &y) {
+template<class T, class Alloc, class I>
+void swap(list<T, Alloc, I> &x, list<T, Alloc, I> &y) {
     x.swap(y);
 }
 }
@@ -0,0 +1,65 @@
+#ifndef PGSTL_MERGE_K_H
+#define PGSTL_MERGE_K_H
+
+#include <cstddef>
+
+#include "list.h"
+#include "priority_queue.h"
+
+namespace pgstl {
+
+/**
+ * 把 [first, last) 中 k 个已排序的链表合并到 *first 中，其余链表被清空
+ * 用一个以各链表当前首元素为键的小顶堆选出下一个节点并 splice 过去，
+ * 时间复杂度 O(n log k)，不拷贝任何元素
+ * 合并是稳定的：相等的元素保持原链表内的顺序，不同链表之间按链表在数组中的先后排列
+ */
+template<class T, class Alloc, class I>
+void merge_k(list<T, Alloc, I> *first, list<T, Alloc, I> *last) {
+    using List = list<T, Alloc, I>;
+    using iterator = typename List::iterator;
+
+    struct Cursor {
+        iterator cur;
+        iterator end;
+        size_t index;
+    };
+
+    // 堆顶是最小的元素，元素相等时下标小的链表优先
+    struct CursorCompare {
+        bool operator()(const Cursor &a, const Cursor &b) const {
+            if (*b.cur < *a.cur)
+                return true;
+            if (*a.cur < *b.cur)
+                return false;
+            return a.index > b.index;
+        }
+    };
+
+    if (last - first < 2)
+        return;
+
+    priority_queue<Cursor, CursorCompare> heap;
+    heap.reserve(last - first);
+    for (List *p = first; p != last; ++p)
+        if (!p->empty())
+            heap.push(Cursor{p->begin(), p->end(), size_t(p - first)});
+
+    List result(first->get_allocator());
+    while (!heap.empty()) {
+        Cursor c = heap.top();
+        iterator node = c.cur;
+        ++c.cur;
+        result.splice(result.end(), first[c.index], node);
+
+        if (c.cur != c.end)
+            heap.replace_top(c);
+        else
+            heap.pop();
+    }
+    first->swap(result);
+}
+
+}
+
+#endif //PGSTL_MERGE_K_H
@@ -0,0 +1,280 @@
+#ifndef PGSTL_PAGE_ALLOCATOR_H
+#define PGSTL_PAGE_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "instrument.h"
+#include "page_provider.h"
+
+namespace pgstl {
+
+/**
+ * 每个线程一个的小对象内存池，从 page_provider 按 2M 的块申请页面后切分
+ * 同一个线程申请的节点在内存中紧密排列，遍历时占用的 TLB 项更少；
+ * 绑定了 NUMA 节点后，这个线程的所有节点都落在本地内存上
+ *
+ * 每个块的开头记录所属的内存池，块按 2M 对齐，释放时用地址掩码就能找到它。
+ * 在别的线程里释放的节点通过无锁的远程空闲链表还给所属的内存池，
+ * 由所属线程在本地空闲链表用完时整体取回，因此生产者 / 消费者模式下
+ * 内存不会在消费者一侧无限堆积，节点也始终留在申请者的 NUMA 节点上。
+ * 线程退出时内存池连同其中的页面和空闲链表交给之后新建的线程继续使用，
+ * 之后对它的远程释放不会丢失；页面在进程结束前不会还给操作系统
+ */
+class page_arena {
+public:
+    // 以 16 字节为粒度划分的大小类别，超过 max_block 或对齐要求超过粒度的请求不经过内存池
+    static const size_t granularity = 16;
+    static const size_t max_block = 512;
+    static const size_t class_count = max_block / granularity;
+    static const size_t chunk_size = page_provider::huge_page_size;
+
+    static page_arena &local() {
+        static thread_local Owner owner;
+        return *owner.arena;
+    }
+
+    /**
+     * 设置当前线程之后申请的页面的策略和 NUMA 节点，已经申请的页面不受影响
+     */
+    void configure(page_policy policy, int numa_node = -1) {
+        _policy = policy;
+        _numaNode = numa_node;
+    }
+
+    void *allocate(size_t bytes, size_t alignment = granularity) {
+        if (bytes == 0)
+            bytes = 1;
+        if (alignment > granularity)
+            return allocateAligned(bytes, alignment);
+        if (bytes > max_block)
+            return ::operator new(bytes);
+
+        size_t index = (bytes - 1) / granularity;
+        FreeBlock *block = _free[index];
+        if (!block && _remote[index].load(std::memory_order_relaxed))
+            block = _remote[index].exchange(nullptr, std::memory_order_acquire);
+        if (block) {
+            _free[index] = block->next;
+            return block;
+        }
+
+        size_t size = (index + 1) * granularity;
+        if (size > size_t(_end - _cur))
+            refill();
+        void *p = _cur;
+        _cur += size;
+        return p;
+    }
+
+    // bytes 和 alignment 必须与申请时相同
+    void deallocate(void *p, size_t bytes, size_t alignment = granularity) {
+        if (bytes == 0)
+            bytes = 1;
+        if (alignment > granularity) {
+            deallocateAligned(p);
+            return;
+        }
+        if (bytes > max_block) {
+            ::operator delete(p);
+            return;
+        }
+
+        size_t index = (bytes - 1) / granularity;
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        page_arena *owner = chunkOf(p)->owner;
+        if (owner == this) {
+            block->next = _free[index];
+            _free[index] = block;
+            return;
+        }
+
+        // 其他线程的节点：压入所属内存池的远程空闲链表，多个线程可以同时压入
+        std::atomic<FreeBlock *> &remote = owner->_remote[index];
+        FreeBlock *head = remote.load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!remote.compare_exchange_weak(head, block, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+protected:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    // 块头，占用每个块开头的一个粒度
+    struct ChunkHeader {
+        page_arena *owner;
+    };
+
+    /**
+     * 线程退出时把内存池放回空闲池，而不是销毁它：
+     * 其他线程可能还持有从这里申请的节点，之后仍会把它们还回来
+     */
+    struct Owner {
+        page_arena *arena;
+
+        Owner() : arena(acquire()) {}
+        ~Owner() { release(arena); }
+    };
+
+    page_arena() : _cur(nullptr), _end(nullptr), _policy(transparent_huge_pages), _numaNode(-1),
+                   _nextIdle(nullptr) {
+        for (size_t i = 0; i < class_count; ++i) {
+            _free[i] = nullptr;
+            _remote[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    static std::mutex &idleMutex() {
+        static std::mutex m;
+        return m;
+    }
+    static page_arena *&idleList() {
+        static page_arena *list = nullptr;
+        return list;
+    }
+
+    // 优先接手已退出线程留下的内存池，页面策略恢复为默认值
+    static page_arena *acquire() {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex());
+            page_arena *arena = idleList();
+            if (arena) {
+                idleList() = arena->_nextIdle;
+                arena->configure(transparent_huge_pages);
+                return arena;
+            }
+        }
+        return new page_arena();
+    }
+    static void release(page_arena *arena) {
+        std::lock_guard<std::mutex> lock(idleMutex());
+        arena->_nextIdle = idleList();
+        idleList() = arena;
+    }
+
+    /**
+     * 块内的节点只按粒度对齐，更大的对齐要求直接向 ::operator new 多申请 alignment 字节再手动对齐，
+     * 原始地址记在返回地址的前面。C++11 没有带对齐参数的 operator new，
+     * 这里不按语言标准切换实现，保证以不同标准编译的代码之间可以互相释放
+     */
+    static void *allocateAligned(size_t bytes, size_t alignment) {
+        if (bytes > size_t(-1) - alignment)
+            throw std::bad_alloc();
+        uintptr_t raw = reinterpret_cast<uintptr_t>(::operator new(bytes + alignment));
+        // raw 按 max_align_t 对齐，对齐后的地址比 raw 至少大一个 max_align_t，足够放下原始地址
+        void **p = reinterpret_cast<void **>((raw + alignment) & ~uintptr_t(alignment - 1));
+        p[-1] = reinterpret_cast<void *>(raw);
+        return p;
+    }
+    static void deallocateAligned(void *p) {
+        ::operator delete(static_cast<void **>(p)[-1]);
+    }
+
+    static ChunkHeader *chunkOf(void *p) {
+        return reinterpret_cast<ChunkHeader *>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(chunk_size - 1));
+    }
+
+    // 当前页面块剩余的尾部直接丢弃，最多浪费 max_block 字节
+    void refill() {
+        page_block block = page_provider::map(chunk_size, _policy, _numaNode);
+        char *base = static_cast<char *>(block.addr);
+        if (reinterpret_cast<uintptr_t>(base) % chunk_size) {
+            // 平台没有保证按 2M 对齐时多申请一块，再手动对齐
+            page_provider::unmap(block);
+            block = page_provider::map(2 * chunk_size, _policy, _numaNode);
+            uintptr_t addr = reinterpret_cast<uintptr_t>(block.addr);
+            base = reinterpret_cast<char *>((addr + chunk_size - 1) & ~uintptr_t(chunk_size - 1));
+        }
+        static_assert(sizeof(ChunkHeader) <= granularity, "chunk header must fit in one granule");
+        reinterpret_cast<ChunkHeader *>(base)->owner = this;
+        _cur = base + granularity;
+        _end = base + chunk_size;
+    }
+
+    FreeBlock *_free[class_count];
+    std::atomic<FreeBlock *> _remote[class_count];
+    char *_cur;
+    char *_end;
+    page_policy _policy;
+    int _numaNode;
+    page_arena *_nextIdle;
+};
+
+/**
+ * 从当前线程的 page_arena 申请内存的分配器，适合 list 这类逐个申请节点的容器
+ * 分配器本身没有状态，所有实例都相等，可以在容器之间自由 splice / swap
+ * @tparam T 元素类型
+ * @tparam Instrument 插桩策略
+ */
+template<class T, class Instrument = default_instrument>
+class page_allocator {
+public:
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using value_type = T;
+    using reference = T &;
+    using const_reference = const T &;
+
+    template<class U>
+    struct rebind {
+        typedef page_allocator<U, Instrument> other;
+    };
+
+public:
+    page_allocator() noexcept = default;
+    page_allocator(const page_allocator &a) noexcept = default;
+
+    template<class U>
+    explicit page_allocator(const page_allocator<U, Instrument> &) noexcept {}
+
+    ~page_allocator() noexcept = default;
+
+    pointer address(reference x) { return &x; }
+    const_pointer address(const_reference x) { return &x; }
+
+    T *allocate(size_type n, const void * = nullptr) {
+        typename Instrument::scope probe(allocator_allocate);
+        if (n > max_size())
+            throw std::bad_alloc();
+        // 检查通过之后 n * sizeof(T) 才不会溢出
+        Instrument::record_length(probe, n * sizeof(T));
+        return static_cast<T *>(page_arena::local().allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(pointer p, size_type n) {
+        typename Instrument::scope probe(allocator_deallocate);
+        page_arena::local().deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(T); }
+
+    void construct(pointer p, const T &value) {
+        ::new(static_cast<void *>(p)) T(value);
+    }
+    void construct(pointer p, T &&value) {
+        ::new(static_cast<void *>(p)) T(std::move(value));
+    }
+
+    void destroy(pointer p) { p->~T(); }
+};
+
+template<typename T1, typename T2, typename I>
+inline bool
+operator==(const page_allocator<T1, I> &, const page_allocator<T2, I> &) { return true; }
+
+template<typename T1, typename T2, typename I>
+inline bool
+operator!=(const page_allocator<T1, I> &, const page_allocator<T2, I> &) { return false; }
+
+}
+
+#endif //PGSTL_PAGE_ALLOCATOR_H
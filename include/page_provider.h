@@ -0,0 +1,171 @@
+#ifndef PGSTL_PAGE_PROVIDER_H
+#define PGSTL_PAGE_PROVIDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef PGSTL_HAVE_NUMA
+#include <numaif.h>
+#endif
+
+namespace pgstl {
+
+/**
+ * 申请页面时的策略
+ * huge_pages: 先尝试 MAP_HUGETLB 显式大页，失败后退化为 transparent_huge_pages
+ * transparent_huge_pages: 普通 mmap 并按 2M 对齐，再用 madvise(MADV_HUGEPAGE) 请求透明大页
+ * small_pages: 普通的 4K 页，用 madvise(MADV_NOHUGEPAGE) 避免透明大页设置为 always 时被合并成大页
+ * Linux 下不论哪种策略，不小于 2M 的映射都按 2M 对齐，上层可以用地址掩码找到所在的块
+ */
+enum page_policy {
+    small_pages,
+    transparent_huge_pages,
+    huge_pages
+};
+
+/**
+ * 一块按页申请的内存
+ */
+struct page_block {
+    void *addr;
+    size_t size;
+    bool huge;      // 是否拿到了显式大页（MAP_HUGETLB）
+};
+
+/**
+ * 按页向操作系统申请内存，供上层的分配器切分使用
+ * Linux 下使用 mmap，开启 PGSTL_HAVE_NUMA 时可以用 mbind 把页面绑定到指定的 NUMA 节点；
+ * 其他平台退化为 ::operator new
+ */
+class page_provider {
+public:
+    static const size_t huge_page_size = size_t(2) << 20;
+
+    static size_t page_size() {
+#if defined(__linux__)
+        static const size_t size = size_t(sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    /**
+     * 申请至少 bytes 字节的页面
+     * @param bytes 申请的大小，会向上取整到页（大页策略下取整到 2M）
+     * @param policy 页面策略，拿不到大页时会逐级退化，不会失败
+     * @param numa_node 要绑定的 NUMA 节点，-1 表示不绑定（由首次访问的线程决定）
+     * @return 申请到的内存块，失败时抛出 std::bad_alloc
+     */
+    static page_block map(size_t bytes, page_policy policy = transparent_huge_pages,
+                          int numa_node = -1) {
+        page_block block = {nullptr, 0, false};
+#if defined(__linux__)
+        if (policy != small_pages)
+            bytes = roundUp(bytes, huge_page_size);
+        else
+            bytes = roundUp(bytes, page_size());
+
+#ifdef MAP_HUGETLB
+        if (policy == huge_pages) {
+            void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                block.addr = p;
+                block.size = bytes;
+                block.huge = true;
+            }
+        }
+#endif
+        if (!block.addr) {
+            block.addr = bytes >= huge_page_size ? mapAligned(bytes) : mapSmall(bytes);
+            block.size = bytes;
+#ifdef MADV_HUGEPAGE
+            if (policy != small_pages)
+                ::madvise(block.addr, bytes, MADV_HUGEPAGE);
+#endif
+#ifdef MADV_NOHUGEPAGE
+            if (policy == small_pages)
+                ::madvise(block.addr, bytes, MADV_NOHUGEPAGE);
+#endif
+        }
+
+        if (numa_node >= 0)
+            bind(block, numa_node);
+#else
+        (void) policy;
+        (void) numa_node;
+        block.addr = ::operator new(bytes);
+        block.size = bytes;
+#endif
+        return block;
+    }
+
+    static void unmap(const page_block &block) {
+#if defined(__linux__)
+        ::munmap(block.addr, block.size);
+#else
+        ::operator delete(block.addr);
+#endif
+    }
+
+    /**
+     * 把内存块绑定到指定的 NUMA 节点，没有 libnuma 时什么也不做
+     * @return 是否绑定成功
+     */
+    static bool bind(const page_block &block, int numa_node) {
+#ifdef PGSTL_HAVE_NUMA
+        if (numa_node < 0 || numa_node >= int(8 * sizeof(unsigned long)))
+            return false;
+        unsigned long mask = 1ul << numa_node;
+        return ::mbind(block.addr, block.size, MPOL_BIND, &mask, 8 * sizeof(mask), 0) == 0;
+#else
+        (void) block;
+        (void) numa_node;
+        return false;
+#endif
+    }
+
+protected:
+    static size_t roundUp(size_t n, size_t align) {
+        return (n + align - 1) / align * align;
+    }
+
+#if defined(__linux__)
+    static void *mapSmall(size_t bytes) {
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    /**
+     * 多申请一个大页的空间，再把首尾多余的部分还回去，得到按 2M 对齐的内存，
+     * 这样透明大页才能覆盖整个区域
+     */
+    static void *mapAligned(size_t bytes) {
+        char *raw = static_cast<char *>(mapSmall(bytes + huge_page_size));
+        uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+        char *aligned = reinterpret_cast<char *>(roundUp(addr, huge_page_size));
+
+        size_t head = size_t(aligned - raw);
+        size_t tail = huge_page_size - head;
+        if (head)
+            ::munmap(raw, head);
+        if (tail)
+            ::munmap(aligned + bytes, tail);
+        return aligned;
+    }
+#endif
+};
+
+}
+
+#endif //PGSTL_PAGE_PROVIDER_H
@@ -0,0 +1,215 @@
+#ifndef PGSTL_PRIORITY_QUEUE_H
+#define PGSTL_PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <utility>
+
+#include "allocator.h"
+#include "functional.h"
+
+namespace pgstl {
+
+/**
+ * 基于 D 叉堆的优先队列，元素存放在一块连续的内存中
+ * 与 std::priority_queue 一样，Compare 为 less 时堆顶是最大的元素
+ * D 越大堆越矮，上浮更快、下沉时每层要比较的孩子更多，4 通常对缓存最友好
+ * @tparam T 元素类型
+ * @tparam Compare 比较函数，Compare(a, b) 为真表示 a 的优先级低于 b
+ * @tparam D 每个节点的孩子个数
+ * @tparam Allocator 分配器
+ */
+template<class T, class Compare = less<T>, size_t D = 4, class Allocator = allocator<T>>
+class priority_queue {
+    static_assert(D >= 2, "priority_queue needs at least two children per node");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using value_compare = Compare;
+    using allocator_type = typename alloc_traits<T, Allocator>::allocator_type;
+
+protected:
+    // 销毁 [data, data + n) 的元素并归还这块内存，用于构造中途抛出异常时的回滚
+    void discard(T *data, size_type n, size_type capacity) {
+        for (size_type i = 0; i < n; ++i)
+            allocator.destroy(data + i);
+        allocator.deallocate(data, capacity);
+    }
+
+    /**
+     * 把容量扩大到至少 n，元素逐个移动到新的内存中
+     * 移动构造可能抛出异常时改为拷贝，全部构造成功后才销毁旧元素，失败时原队列不变
+     */
+    void grow(size_type n) {
+        if (n <= _capacity)
+            return;
+        if (n < 2 * _capacity)
+            n = 2 * _capacity;
+
+        T *data = allocator.allocate(n);
+        size_type i = 0;
+        try {
+            for (; i < _size; ++i)
+                allocator.construct(data + i, std::move_if_noexcept(_data[i]));
+        } catch (...) {
+            discard(data, i, n);
+            throw;
+        }
+        if (_data)
+            discard(_data, _size, _capacity);
+        _data = data;
+        _capacity = n;
+    }
+
+    /**
+     * 把 hole 处的空位沿着父节点方向上移，直到可以放下 x
+     */
+    void siftUp(size_type hole, T &x) {
+        while (hole > 0) {
+            size_type parent = (hole - 1) / D;
+            if (!comp(_data[parent], x))
+                break;
+            _data[hole] = std::move(_data[parent]);
+            hole = parent;
+        }
+        _data[hole] = std::move(x);
+    }
+
+    /**
+     * 把 hole 处的空位沿着优先级最高的孩子方向下移，直到可以放下 x
+     */
+    void siftDown(size_type hole, T &x) {
+        for (;;) {
+            size_type child = hole * D + 1;
+            if (child >= _size)
+                break;
+
+            size_type best = child;
+            size_type last = child + D < _size ? child + D : _size;
+            for (++child; child < last; ++child)
+                if (comp(_data[best], _data[child]))
+                    best = child;
+
+            if (!comp(x, _data[best]))
+                break;
+            _data[hole] = std::move(_data[best]);
+            hole = best;
+        }
+        _data[hole] = std::move(x);
+    }
+
+public:
+    explicit priority_queue(const Compare &compare = Compare(),
+                            const allocator_type &alloc = allocator_type()) :
+            _data(nullptr), _size(0), _capacity(0), comp(compare), allocator(alloc) {}
+
+    priority_queue(const priority_queue &x) :
+            _data(nullptr), _size(0), _capacity(0), comp(x.comp), allocator(x.allocator) {
+        grow(x._size);
+        try {
+            for (; _size < x._size; ++_size)
+                allocator.construct(_data + _size, x._data[_size]);
+        } catch (...) {
+            // 构造函数抛出异常时析构函数不会执行，已经拷贝的元素和内存要在这里还回去
+            discard(_data, _size, _capacity);
+            throw;
+        }
+    }
+
+    ~priority_queue() {
+        clear();
+        if (_data)
+            allocator.deallocate(_data, _capacity);
+    }
+
+    priority_queue &operator=(const priority_queue &x) {
+        if (this != &x) {
+            priority_queue tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    bool empty() const { return _size == 0; }
+    size_type size() const { return _size; }
+    size_type capacity() const { return _capacity; }
+
+    const_reference top() const { return _data[0]; }
+
+    void reserve(size_type n) { grow(n); }
+
+    void push(const T &x) {
+        T tmp(x);
+        push(std::move(tmp));
+    }
+    void push(T &&x) {
+        if (_size == _capacity)
+            grow(_size + 1);
+        T tmp(std::move(x));
+        // 末尾的空位还没有构造：需要上移时用父节点移动构造它，否则直接用 x 构造
+        // 构造成功之后才增加 _size，构造时抛出异常不会留下未初始化的槽位
+        size_type hole = _size;
+        if (hole > 0) {
+            size_type parent = (hole - 1) / D;
+            if (comp(_data[parent], tmp)) {
+                allocator.construct(_data + hole, std::move(_data[parent]));
+                ++_size;
+                siftUp(parent, tmp);
+                return;
+            }
+        }
+        allocator.construct(_data + hole, std::move(tmp));
+        ++_size;
+    }
+
+    void pop() {
+        --_size;
+        if (_size) {
+            T tmp(std::move(_data[_size]));
+            allocator.destroy(_data + _size);
+            siftDown(0, tmp);
+        } else {
+            allocator.destroy(_data);
+        }
+    }
+
+    /**
+     * 用 x 替换堆顶并恢复堆序，相当于 pop() 后 push(x)，但只需要一次下沉
+     */
+    void replace_top(const T &x) {
+        T tmp(x);
+        siftDown(0, tmp);
+    }
+
+    void clear() {
+        for (; _size; --_size)
+            allocator.destroy(_data + _size - 1);
+    }
+
+    void swap(priority_queue &x) {
+        std::swap(_data, x._data);
+        std::swap(_size, x._size);
+        std::swap(_capacity, x._capacity);
+        std::swap(comp, x.comp);
+        std::swap(allocator, x.allocator);
+    }
+
+protected:
+    T *_data;
+    size_type _size;
+    size_type _capacity;
+    Compare comp;
+    allocator_type allocator;
+};
+
+template<class T, class Compare, size_t D, class Allocator>
+void swap(priority_queue<T, Compare, D, Allocator> &x,
+          priority_queue<T, Compare, D, Allocator> &y) {
+    x.swap(y);
+}
+
+}
+
+#endif //PGSTL_PRIORITY_QUEUE_H
@@ -0,0 +1,569 @@
+#ifndef PGSTL_STATIC_LIST_H
+#define PGSTL_STATIC_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "config.h"
+#include "iterator.h"
+
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+#include <memory>
+#endif
+
+namespace pgstl {
+
+/**
+ * static_list 的节点，用数组下标代替指针来链接
+ * 下标 N 是哨兵节点，它的 _data 永远不会被构造
+ */
+template<class T>
+struct StaticListNode {
+    size_t _next;
+    size_t _prev;
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+    // 匿名 union 的成员不会被自动构造或析构，由 static_list 显式管理
+    union {
+        T _data;
+    };
+
+    constexpr StaticListNode() {}
+    constexpr ~StaticListNode() {}
+
+    constexpr T &data() { return _data; }
+    constexpr const T &data() const { return _data; }
+#else
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _data;
+
+    T &data() { return *reinterpret_cast<T *>(&_data); }
+    const T &data() const { return *reinterpret_cast<const T *>(&_data); }
+#endif
+};
+
+template<class T>
+struct StaticListIterator {
+    using Self = StaticListIterator<T>;
+    using Node = StaticListNode<T>;
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+    using iterator_category = bidirectional_iterator_tag;
+
+    Node *_nodes;
+    size_type _index;
+
+    PGSTL_CONSTEXPR20 StaticListIterator() : _nodes(nullptr), _index(0) {}
+    PGSTL_CONSTEXPR20 StaticListIterator(Node *nodes, size_type index) : _nodes(nodes), _index(index) {}
+
+    PGSTL_CONSTEXPR20 bool operator==(const Self &x) const { return _index == x._index && _nodes == x._nodes; }
+    PGSTL_CONSTEXPR20 bool operator!=(const Self &x) const { return !(*this == x); }
+
+    PGSTL_CONSTEXPR20 reference operator*() const { return _nodes[_index].data(); }
+    PGSTL_CONSTEXPR20 pointer operator->() const { return &(operator*()); }
+
+    PGSTL_CONSTEXPR20 Self &operator++() {
+        _index = _nodes[_index]._next;
+        return *this;
+    }
+    PGSTL_CONSTEXPR20 Self operator++(int) {
+        Self tmp = *this;
+        _index = _nodes[_index]._next;
+        return tmp;
+    }
+
+    PGSTL_CONSTEXPR20 Self &operator--() {
+        _index = _nodes[_index]._prev;
+        return *this;
+    }
+    PGSTL_CONSTEXPR20 Self operator--(int) {
+        Self tmp = *this;
+        _index = _nodes[_index]._prev;
+        return tmp;
+    }
+};
+
+template<class T>
+struct StaticListConstIterator {
+    using Self = StaticListConstIterator<T>;
+    using Node = StaticListNode<T>;
+    using iterator = StaticListIterator<T>;
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+    using iterator_category = bidirectional_iterator_tag;
+
+    const Node *_nodes;
+    size_type _index;
+
+    PGSTL_CONSTEXPR20 StaticListConstIterator() : _nodes(nullptr), _index(0) {}
+    PGSTL_CONSTEXPR20 StaticListConstIterator(const Node *nodes, size_type index) : _nodes(nodes), _index(index) {}
+    PGSTL_CONSTEXPR20 StaticListConstIterator(const iterator &x) : _nodes(x._nodes), _index(x._index) {}
+
+    PGSTL_CONSTEXPR20 bool operator==(const Self &x) const { return _index == x._index && _nodes == x._nodes; }
+    PGSTL_CONSTEXPR20 bool operator!=(const Self &x) const { return !(*this == x); }
+
+    PGSTL_CONSTEXPR20 reference operator*() const { return _nodes[_index].data(); }
+    PGSTL_CONSTEXPR20 pointer operator->() const { return &(operator*()); }
+
+    PGSTL_CONSTEXPR20 Self &operator++() {
+        _index = _nodes[_index]._next;
+        return *this;
+    }
+    PGSTL_CONSTEXPR20 Self operator++(int) {
+        Self tmp = *this;
+        _index = _nodes[_index]._next;
+        return tmp;
+    }
+
+    PGSTL_CONSTEXPR20 Self &operator--() {
+        _index = _nodes[_index]._prev;
+        return *this;
+    }
+    PGSTL_CONSTEXPR20 Self operator--(int) {
+        Self tmp = *this;
+        _index = _nodes[_index]._prev;
+        return tmp;
+    }
+};
+
+/**
+ * 固定容量的双向链表，节点全部放在对象内部的数组中，从不申请堆内存
+ * 接口与 list 保持一致；同一个容器内的 splice / merge / sort / reverse 只修改下标，
+ * 不拷贝元素。跨容器的 splice / merge 由于节点不能共享，只能拷贝元素后再删除原节点
+ * @tparam T 元素类型
+ * @tparam N 最大容量，超出容量的插入属于未定义行为（debug 下会断言）
+ */
+template<class T, size_t N>
+class static_list {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = StaticListIterator<T>;
+    using const_iterator = StaticListConstIterator<T>;
+    using reverse_iterator = pgstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = pgstl::reverse_iterator<const_iterator>;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+protected:
+    using Node = StaticListNode<T>;
+
+    // 哨兵节点的下标，同时作为空闲链表的结束标记
+    static const size_type nil = N;
+
+    PGSTL_CONSTEXPR20 size_type createNode() {
+        assert(_free != nil);
+        size_type p = _free;
+        _free = _nodes[p]._next;
+        return p;
+    }
+    PGSTL_CONSTEXPR20 void deleteNode(size_type p) {
+        _nodes[p]._next = _free;
+        _free = p;
+    }
+
+    PGSTL_CONSTEXPR20 size_type constructNode(const T &x) {
+        size_type p = createNode();
+        try {
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+            std::construct_at(&_nodes[p]._data, x);
+#else
+            ::new(static_cast<void *>(&_nodes[p]._data)) T(x);
+#endif
+        } catch (...) {
+            deleteNode(p);
+            throw;
+        }
+        return p;
+    }
+    PGSTL_CONSTEXPR20 void destroyNode(size_type p) {
+        destroyData(p, std::is_trivially_destructible<T>());
+        deleteNode(p);
+    }
+    PGSTL_CONSTEXPR20 void destroyData(size_type, std::true_type) {}
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+    constexpr void destroyData(size_type p, std::false_type) { std::destroy_at(&_nodes[p]._data); }
+#else
+    void destroyData(size_type p, std::false_type) { _nodes[p].data().~T(); }
+#endif
+
+    PGSTL_CONSTEXPR20 void initList() {
+        _nodes[nil]._next = nil;
+        _nodes[nil]._prev = nil;
+        _free = 0;
+        for (size_type i = 0; i < N; ++i)
+            _nodes[i]._next = i + 1;
+        _size = 0;
+    }
+
+    PGSTL_CONSTEXPR20 iterator makeIterator(size_type i) { return iterator(_nodes, i); }
+
+    PGSTL_CONSTEXPR20 void transfer(size_type position, size_type first, size_type last) {
+        if (position != last) {
+            _nodes[_nodes[last]._prev]._next = position;
+            _nodes[_nodes[first]._prev]._next = last;
+            _nodes[_nodes[position]._prev]._next = first;
+
+            size_type tmp = _nodes[position]._prev;
+            _nodes[position]._prev = _nodes[last]._prev;
+            _nodes[last]._prev = _nodes[first]._prev;
+            _nodes[first]._prev = tmp;
+        }
+    }
+
+    /**
+     * 合并两条以 nil 结尾的单向链（只使用 _next），相等时 a 中的元素在前，保证稳定
+     * @return 合并后链的首节点
+     */
+    PGSTL_CONSTEXPR20 size_type mergeChains(size_type a, size_type b) {
+        size_type head = nil;
+        size_type *tail = &head;
+        while (a != nil && b != nil) {
+            if (_nodes[b].data() < _nodes[a].data()) {
+                *tail = b;
+                b = _nodes[b]._next;
+            } else {
+                *tail = a;
+                a = _nodes[a]._next;
+            }
+            tail = &_nodes[*tail]._next;
+        }
+        *tail = (a != nil) ? a : b;
+        return head;
+    }
+
+public:
+    PGSTL_CONSTEXPR20 static_list() { initList(); }
+    PGSTL_CONSTEXPR20 explicit static_list(size_type n, const value_type &val = value_type()) {
+        initList();
+        assign(n, val);
+    }
+    PGSTL_CONSTEXPR20 static_list(const T *first, const T *last) {
+        initList();
+        assign(first, last);
+    }
+    PGSTL_CONSTEXPR20 static_list(const_iterator first, const_iterator last) {
+        initList();
+        assign(first, last);
+    }
+    PGSTL_CONSTEXPR20 static_list(const static_list &x) {
+        initList();
+        assign(x.begin(), x.end());
+    }
+
+    PGSTL_CONSTEXPR20 ~static_list() { clear(); }
+
+    PGSTL_CONSTEXPR20 static_list &operator=(const static_list &x) {
+        if (this != &x)
+            assign(x.begin(), x.end());
+        return *this;
+    }
+
+    PGSTL_CONSTEXPR20 iterator begin() { return iterator(_nodes, _nodes[nil]._next); }
+    PGSTL_CONSTEXPR20 iterator end() { return iterator(_nodes, nil); }
+    PGSTL_CONSTEXPR20 const_iterator begin() const { return const_iterator(_nodes, _nodes[nil]._next); }
+    PGSTL_CONSTEXPR20 const_iterator end() const { return const_iterator(_nodes, nil); }
+
+    PGSTL_CONSTEXPR20 reverse_iterator rbegin() { return reverse_iterator(end()); }
+    PGSTL_CONSTEXPR20 const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    PGSTL_CONSTEXPR20 reverse_iterator rend() { return reverse_iterator(begin()); }
+    PGSTL_CONSTEXPR20 const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    PGSTL_CONSTEXPR20 bool empty() const { return _size == 0; }
+    PGSTL_CONSTEXPR20 bool full() const { return _size == N; }
+    PGSTL_CONSTEXPR20 size_type size() const { return _size; }
+    PGSTL_CONSTEXPR20 size_type max_size() const { return N; }
+    PGSTL_CONSTEXPR20 size_type capacity() const { return N; }
+
+    PGSTL_CONSTEXPR20 reference front() { return *begin(); }
+    PGSTL_CONSTEXPR20 const_reference front() const { return *begin(); }
+    PGSTL_CONSTEXPR20 reference back() {
+        iterator tmp = end();
+        --tmp;
+        return *tmp;
+    }
+    PGSTL_CONSTEXPR20 const_reference back() const {
+        const_iterator tmp = end();
+        --tmp;
+        return *tmp;
+    }
+
+    PGSTL_CONSTEXPR20 void assign(const_iterator first, const_iterator last) {
+        clear();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+    PGSTL_CONSTEXPR20 void assign(const T *first, const T *last) {
+        clear();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+    PGSTL_CONSTEXPR20 void assign(size_type n, const value_type &val) {
+        clear();
+        for (; n; --n)
+            push_back(val);
+    }
+
+    PGSTL_CONSTEXPR20 iterator insert(iterator position, const T &x) {
+        size_type tmp = constructNode(x);
+        size_type pos = position._index;
+        _nodes[tmp]._next = pos;
+        _nodes[tmp]._prev = _nodes[pos]._prev;
+
+        _nodes[_nodes[pos]._prev]._next = tmp;
+        _nodes[pos]._prev = tmp;
+        ++_size;
+        return makeIterator(tmp);
+    }
+    PGSTL_CONSTEXPR20 void insert(iterator position, size_type n, const value_type &val) {
+        for (; n; --n)
+            insert(position, val);
+    }
+    PGSTL_CONSTEXPR20 void push_front(const T &x) { insert(begin(), x); }
+    PGSTL_CONSTEXPR20 void push_back(const T &x) { insert(end(), x); }
+
+    PGSTL_CONSTEXPR20 iterator erase(iterator position) {
+        size_type pos = position._index;
+        size_type next_node = _nodes[pos]._next;
+        size_type prev_node = _nodes[pos]._prev;
+        _nodes[prev_node]._next = next_node;
+        _nodes[next_node]._prev = prev_node;
+        destroyNode(pos);
+        --_size;
+        return makeIterator(next_node);
+    }
+    PGSTL_CONSTEXPR20 iterator erase(iterator first, iterator last) {
+        while (first != last)
+            first = erase(first);
+        return last;
+    }
+    PGSTL_CONSTEXPR20 void pop_front() { erase(begin()); }
+    PGSTL_CONSTEXPR20 void pop_back() {
+        iterator tmp = end();
+        erase(--tmp);
+    }
+
+    PGSTL_CONSTEXPR20 void resize(size_type n, value_type val = value_type()) {
+        while (_size > n)
+            pop_back();
+        while (_size < n)
+            push_back(val);
+    }
+
+    PGSTL_CONSTEXPR20 void clear() {
+        size_type cur = _nodes[nil]._next;
+
+        while (cur != nil) {
+            size_type tmp = cur;
+            cur = _nodes[cur]._next;
+            destroyNode(tmp);
+        }
+
+        _nodes[nil]._next = nil;
+        _nodes[nil]._prev = nil;
+        _size = 0;
+    }
+
+    PGSTL_CONSTEXPR20 void remove(const T &value) {
+        iterator first = begin();
+        iterator last = end();
+
+        while (first != last) {
+            iterator next = first;
+            ++next;
+            if (*first == value)
+                erase(first);
+            first = next;
+        }
+    }
+
+    PGSTL_CONSTEXPR20 void unique() {
+        if (empty()) return;
+
+        iterator first = begin();
+        iterator last = end();
+        iterator next = first;
+
+        while (++next != last) {
+            if (*first == *next)
+                erase(next);
+            else
+                first = next;
+            next = first;
+        }
+    }
+
+    PGSTL_CONSTEXPR20 void splice(iterator position, static_list &x) {
+        splice(position, x, x.begin(), x.end());
+    }
+
+    PGSTL_CONSTEXPR20 void splice(iterator position, static_list &x, iterator i) {
+        iterator j = i;
+        ++j;
+        splice(position, x, i, j);
+    }
+
+    PGSTL_CONSTEXPR20 void splice(iterator position, static_list &x, iterator first, iterator last) {
+        if (first == last || position == last)
+            return;
+
+        if (&x == this) {
+            if (position == first)
+                return;
+            transfer(position._index, first._index, last._index);
+            return;
+        }
+
+        while (first != last) {
+            insert(position, *first);
+            first = x.erase(first);
+        }
+    }
+
+    PGSTL_CONSTEXPR20 void merge(static_list &x) {
+        if (&x == this)
+            return;
+
+        iterator first1 = begin();
+        iterator last1 = end();
+        iterator first2 = x.begin();
+        iterator last2 = x.end();
+
+        while (first1 != last1 && first2 != last2) {
+            if (*first2 < *first1) {
+                insert(first1, *first2);
+                first2 = x.erase(first2);
+            } else {
+                ++first1;
+            }
+        }
+        splice(last1, x, first2, last2);
+    }
+
+    PGSTL_CONSTEXPR20 void reverse() {
+        size_type cur = nil;
+        do {
+            Node &node = _nodes[cur];
+            size_type tmp = node._next;
+            node._next = node._prev;
+            node._prev = tmp;
+            cur = tmp;
+        } while (cur != nil);
+    }
+
+    PGSTL_CONSTEXPR20 void sort() {
+        if (_size < 2)
+            return;
+
+        // 与 list::sort 相同的自底向上归并，只是 counter 中存放的是单向链的首节点
+        size_type counter[64];
+        int fill = 0;
+
+        size_type cur = _nodes[nil]._next;
+        while (cur != nil) {
+            size_type carry = cur;
+            cur = _nodes[cur]._next;
+            _nodes[carry]._next = nil;
+
+            int i = 0;
+            while (i < fill && counter[i] != nil) {
+                carry = mergeChains(counter[i], carry);
+                counter[i++] = nil;
+            }
+            counter[i] = carry;
+            if (i == fill)
+                ++fill;
+        }
+
+        size_type head = nil;
+        for (int i = 0; i < fill; ++i)
+            if (counter[i] != nil)
+                head = mergeChains(counter[i], head);
+
+        // 按新的顺序恢复 _prev 链接
+        size_type prev = nil;
+        _nodes[nil]._next = head;
+        for (cur = head; cur != nil; cur = _nodes[cur]._next) {
+            _nodes[cur]._prev = prev;
+            prev = cur;
+        }
+        _nodes[prev]._next = nil;
+        _nodes[nil]._prev = prev;
+    }
+
+    PGSTL_CONSTEXPR20 void swap(static_list &x) {
+        const static_list temp(*this);
+        *this = x;
+        x = temp;
+    }
+
+protected:
+    Node _nodes[N + 1];
+    size_type _free;
+    size_type _size;
+};
+
+template<class T, size_t N>
+const typename static_list<T, N>::size_type static_list<T, N>::nil;
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator==(const static_list<T, N> &lhs, const static_list<T, N> &rhs) {
+    auto end1 = lhs.end();
+    auto end2 = rhs.end();
+
+    auto i1 = lhs.begin();
+    auto i2 = rhs.begin();
+    while (i1 != end1 && i2 != end2 && *i1 == *i2) {
+        ++i1;
+        ++i2;
+    }
+    return i1 == end1 && i2 == end2;
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator!=(const static_list<T, N> &lhs, const static_list<T, N> &rhs) {
+    return !(lhs == rhs);
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator<(const static_list<T, N> &lhs, const static_list<T, N> &rhs) {
+    return lexicographical_compare(
+            lhs.begin(), lhs.end(),
+            rhs.begin(), rhs.end());
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator<=(const static_list<T, N> &lhs, const static_list<T, N> &rhs) {
+    return !(lhs > rhs);
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator>(const static_list<T, N> &lhs, const static_list<T, N> &rhs) {
+    return rhs < lhs;
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator>=(const static_list<T, N> &lhs, const static_list<T, N> &rhs) {
+    return !(lhs < rhs);
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 void swap(static_list<T, N> &x, static_list<T, N> &y) {
+    x.swap(y);
+}
+
+}
+
+#endif //PGSTL_STATIC_LIST_H
@@ -0,0 +1,252 @@
+#ifndef PGSTL_STATIC_VECTOR_H
+#define PGSTL_STATIC_VECTOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "config.h"
+#include "iterator.h"
+
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+#include <memory>
+#endif
+
+namespace pgstl {
+
+/**
+ * 固定容量的顺序容器，元素直接存放在对象内部，从不申请堆内存
+ * @tparam T 元素类型
+ * @tparam N 最大容量，超出容量的插入属于未定义行为（debug 下会断言）
+ */
+template<class T, size_t N>
+class static_vector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = pgstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = pgstl::reverse_iterator<const_iterator>;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+protected:
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+    // 空的构造和析构函数让 union 不会自动构造或析构任何元素，元素的生命周期由 _size 管理
+    union Storage {
+        constexpr Storage() {}
+        constexpr ~Storage() {}
+        T _elems[N];
+    };
+
+    constexpr void construct(pointer p, const T &value) {
+        std::construct_at(p, value);
+    }
+#else
+    using StorageType = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    void construct(pointer p, const T &value) {
+        ::new(static_cast<void *>(p)) T(value);
+    }
+#endif
+    PGSTL_CONSTEXPR20 void destroy(pointer p) {
+        destroy(p, std::is_trivially_destructible<T>());
+    }
+    PGSTL_CONSTEXPR20 void destroy(pointer, std::true_type) {}
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+    constexpr void destroy(pointer p, std::false_type) { std::destroy_at(p); }
+#else
+    void destroy(pointer p, std::false_type) { p->~T(); }
+#endif
+
+public:
+    PGSTL_CONSTEXPR20 static_vector() : _size(0) {}
+    PGSTL_CONSTEXPR20 explicit static_vector(size_type n, const value_type &val = value_type()) :
+            _size(0) {
+        assign(n, val);
+    }
+    PGSTL_CONSTEXPR20 static_vector(const T *first, const T *last) : _size(0) {
+        assign(first, last);
+    }
+    PGSTL_CONSTEXPR20 static_vector(const static_vector &x) : _size(0) {
+        assign(x.begin(), x.end());
+    }
+
+    PGSTL_CONSTEXPR20 ~static_vector() { clear(); }
+
+    PGSTL_CONSTEXPR20 static_vector &operator=(const static_vector &x) {
+        if (this != &x)
+            assign(x.begin(), x.end());
+        return *this;
+    }
+
+    PGSTL_CONSTEXPR20 iterator begin() { return data(); }
+    PGSTL_CONSTEXPR20 iterator end() { return data() + _size; }
+    PGSTL_CONSTEXPR20 const_iterator begin() const { return data(); }
+    PGSTL_CONSTEXPR20 const_iterator end() const { return data() + _size; }
+
+    PGSTL_CONSTEXPR20 reverse_iterator rbegin() { return reverse_iterator(end()); }
+    PGSTL_CONSTEXPR20 const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    PGSTL_CONSTEXPR20 reverse_iterator rend() { return reverse_iterator(begin()); }
+    PGSTL_CONSTEXPR20 const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    PGSTL_CONSTEXPR20 bool empty() const { return _size == 0; }
+    PGSTL_CONSTEXPR20 bool full() const { return _size == N; }
+    PGSTL_CONSTEXPR20 size_type size() const { return _size; }
+    PGSTL_CONSTEXPR20 size_type max_size() const { return N; }
+    PGSTL_CONSTEXPR20 size_type capacity() const { return N; }
+
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+    constexpr pointer data() { return _storage._elems; }
+    constexpr const_pointer data() const { return _storage._elems; }
+#else
+    pointer data() { return reinterpret_cast<pointer>(_data); }
+    const_pointer data() const { return reinterpret_cast<const_pointer>(_data); }
+#endif
+
+    PGSTL_CONSTEXPR20 reference operator[](size_type n) { return data()[n]; }
+    PGSTL_CONSTEXPR20 const_reference operator[](size_type n) const { return data()[n]; }
+
+    PGSTL_CONSTEXPR20 reference front() { return *begin(); }
+    PGSTL_CONSTEXPR20 const_reference front() const { return *begin(); }
+    PGSTL_CONSTEXPR20 reference back() { return *(end() - 1); }
+    PGSTL_CONSTEXPR20 const_reference back() const { return *(end() - 1); }
+
+    PGSTL_CONSTEXPR20 void assign(const T *first, const T *last) {
+        clear();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+    PGSTL_CONSTEXPR20 void assign(size_type n, const value_type &val) {
+        clear();
+        for (; n; --n)
+            push_back(val);
+    }
+
+    PGSTL_CONSTEXPR20 void push_back(const T &x) {
+        assert(_size < N);
+        construct(end(), x);
+        ++_size;
+    }
+    PGSTL_CONSTEXPR20 void pop_back() {
+        --_size;
+        destroy(end());
+    }
+
+    PGSTL_CONSTEXPR20 iterator insert(iterator position, const T &x) {
+        assert(_size < N);
+        if (position == end()) {
+            push_back(x);
+            return end() - 1;
+        }
+
+        // x 可能引用容器内的元素，先拷贝一份再挪动
+        value_type tmp(x);
+        construct(end(), back());
+        for (iterator cur = end() - 1; cur != position; --cur)
+            *cur = *(cur - 1);
+        *position = tmp;
+        ++_size;
+        return position;
+    }
+    PGSTL_CONSTEXPR20 void insert(iterator position, size_type n, const value_type &val) {
+        for (; n; --n)
+            position = insert(position, val) + 1;
+    }
+
+    PGSTL_CONSTEXPR20 iterator erase(iterator position) {
+        for (iterator cur = position + 1; cur != end(); ++cur)
+            *(cur - 1) = *cur;
+        pop_back();
+        return position;
+    }
+    PGSTL_CONSTEXPR20 iterator erase(iterator first, iterator last) {
+        if (first == last)
+            return first;
+
+        iterator dst = first;
+        for (iterator cur = last; cur != end(); ++cur, ++dst)
+            *dst = *cur;
+        while (end() != dst)
+            pop_back();
+        return first;
+    }
+
+    PGSTL_CONSTEXPR20 void resize(size_type n, value_type val = value_type()) {
+        while (_size > n)
+            pop_back();
+        while (_size < n)
+            push_back(val);
+    }
+
+    PGSTL_CONSTEXPR20 void clear() {
+        while (_size)
+            pop_back();
+    }
+
+    PGSTL_CONSTEXPR20 void swap(static_vector &x) {
+        const static_vector temp(*this);
+        *this = x;
+        x = temp;
+    }
+
+protected:
+#ifdef PGSTL_CONSTEXPR_CONTAINERS
+    Storage _storage;
+#else
+    StorageType _data[N];
+#endif
+    size_type _size;
+};
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator==(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (size_t i = 0; i < lhs.size(); ++i)
+        if (!(lhs[i] == rhs[i]))
+            return false;
+    return true;
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator!=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return !(lhs == rhs);
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator<(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return lexicographical_compare(
+            lhs.begin(), lhs.end(),
+            rhs.begin(), rhs.end());
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator<=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return !(lhs > rhs);
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator>(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return rhs < lhs;
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 bool operator>=(const static_vector<T, N> &lhs, const static_vector<T, N> &rhs) {
+    return !(lhs < rhs);
+}
+
+template<class T, size_t N>
+PGSTL_CONSTEXPR20 void swap(static_vector<T, N> &x, static_vector<T, N> &y) {
+    x.swap(y);
+}
+
+}
+
+#endif //PGSTL_STATIC_VECTOR_H
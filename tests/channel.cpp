@@ -0,0 +1,247 @@
+// channel 的测试
+// 1. 多个生产者用 push / push_n 写入，多个消费者用 pop / pop_n 读取，检查每个元素恰好被取出一次
+// 2. close 之后 push 失败，pop 把剩余元素取完后返回 false
+// 3. 以 C++20 编译时（PGSTL_TEST_COROUTINE）再检查 co_await pop() 的各条路径：
+//    直接取到元素、挂起后由生产者交付、close 和析构时以 std::nullopt 恢复、交付时拷贝抛出异常
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "channel.h"
+
+#if defined(PGSTL_TEST_COROUTINE) && !defined(PGSTL_HAS_COROUTINE)
+#error "channel_coroutine must be built with C++20 coroutine support"
+#endif
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",              \
+                         __FILE__, __LINE__, #cond);                        \
+            std::exit(1);                                                   \
+        }                                                                   \
+    } while (0)
+
+namespace {
+
+const int producerCount = 4;
+const int consumerCount = 3;
+const int perProducer = 20000;
+
+// 生产者 p 写入 p * perProducer 到 (p + 1) * perProducer - 1，偶数号生产者批量写入
+void testManyProducers() {
+    pgstl::channel<int> ch(64);
+    std::vector<std::atomic<int>> seen(producerCount * perProducer);
+    for (std::atomic<int> &s : seen)
+        s.store(0);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&ch, p] {
+            int base = p * perProducer;
+            if (p % 2 == 0) {
+                int buf[37];
+                for (int i = 0; i < perProducer;) {
+                    int n = perProducer - i < 37 ? perProducer - i : 37;
+                    for (int k = 0; k < n; ++k)
+                        buf[k] = base + i + k;
+                    CHECK(ch.push_n(buf, buf + n) == size_t(n));
+                    i += n;
+                }
+            } else {
+                for (int i = 0; i < perProducer; ++i)
+                    CHECK(ch.push(base + i));
+            }
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < consumerCount; ++c) {
+        consumers.emplace_back([&ch, &seen, c] {
+            int buf[16];
+            for (;;) {
+                size_t n;
+                if (c % 2 == 0) {
+                    n = ch.pop_n(buf, 16);
+                } else {
+                    n = ch.pop(buf[0]) ? 1 : 0;
+                }
+                if (n == 0)
+                    return;
+                for (size_t k = 0; k < n; ++k)
+                    seen[buf[k]].fetch_add(1);
+            }
+        });
+    }
+
+    for (std::thread &t : producers)
+        t.join();
+    ch.close();
+    for (std::thread &t : consumers)
+        t.join();
+
+    for (std::atomic<int> &s : seen)
+        CHECK(s.load() == 1);
+    CHECK(ch.empty());
+}
+
+void testCloseAndDrain() {
+    pgstl::channel<int> ch(4);
+    CHECK(ch.try_push(1));
+    CHECK(ch.push(2));
+    const int more[] = {3, 4};
+    CHECK(ch.push_n(more, more + 2) == 2);
+    CHECK(!ch.try_push(6));
+
+    ch.close();
+    CHECK(ch.closed());
+    CHECK(!ch.push(7));
+    CHECK(!ch.try_push(7));
+
+    int x = 0;
+    CHECK(ch.pop(x) && x == 1);
+    int buf[8];
+    CHECK(ch.pop_n(buf, 8) == 3);
+    CHECK(buf[0] == 2 && buf[1] == 3 && buf[2] == 4);
+    CHECK(!ch.pop(x));
+    CHECK(!ch.try_pop(x));
+    CHECK(ch.pop_n(buf, 8) == 0);
+}
+
+// 消费者阻塞在 pop 上时 close 要能唤醒它
+void testCloseWakesConsumer() {
+    pgstl::channel<int> ch(2);
+    std::atomic<bool> done(false);
+    std::thread consumer([&ch, &done] {
+        int x;
+        CHECK(!ch.pop(x));
+        done.store(true);
+    });
+    ch.close();
+    consumer.join();
+    CHECK(done.load());
+}
+
+}
+
+#ifdef PGSTL_TEST_COROUTINE
+namespace {
+
+// 立即开始执行、结束后自动销毁的最简单的协程类型
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::abort(); }
+    };
+};
+
+// 没有默认构造函数，拷贝次数可以被设为在某一次抛出异常
+int copyBudget = -1;
+
+struct Value {
+    int v;
+
+    explicit Value(int x) : v(x) {}
+    Value(const Value &x) : v(x.v) {
+        if (copyBudget == 0)
+            throw std::runtime_error("copy failed");
+        if (copyBudget > 0)
+            --copyBudget;
+    }
+    Value &operator=(const Value &) = default;
+};
+
+struct Consumer {
+    int sum = 0;
+    int received = 0;
+    int closedCount = 0;
+};
+
+Task consume(pgstl::channel<Value> &ch, Consumer &c) {
+    for (;;) {
+        std::optional<Value> x = co_await ch.pop();
+        if (!x) {
+            ++c.closedCount;
+            co_return;
+        }
+        c.sum += x->v;
+        ++c.received;
+    }
+}
+
+void testCoroutineReadyAndHandOff() {
+    pgstl::channel<Value> ch(4);
+    Consumer c;
+    ch.push(Value(1));
+    ch.push(Value(2));
+    consume(ch, c);  // 先取走缓冲区中的两个元素，然后挂起
+    CHECK(c.received == 2);
+
+    std::thread producer([&ch] {
+        for (int i = 3; i <= 100; ++i)
+            CHECK(ch.push(Value(i)));
+    });
+    producer.join();
+    CHECK(c.received == 100 && c.sum == 5050);
+
+    ch.close();
+    CHECK(c.closedCount == 1);
+}
+
+void testCoroutineResumedOnDestruction() {
+    Consumer c;
+    {
+        pgstl::channel<Value> ch(2);
+        consume(ch, c);
+        CHECK(c.closedCount == 0);
+    }
+    CHECK(c.closedCount == 1);
+}
+
+// 交付时的拷贝抛出异常，等待者不能丢失
+void testHandOffCopyThrows() {
+    pgstl::channel<Value> ch(2);
+    Consumer c;
+    consume(ch, c);
+
+    Value v(7);
+    copyBudget = 0;
+    bool threw = false;
+    try {
+        ch.push(v);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    copyBudget = -1;
+    CHECK(threw);
+    CHECK(c.received == 0);
+
+    CHECK(ch.push(v));
+    CHECK(c.received == 1 && c.sum == 7);
+    ch.close();
+    CHECK(c.closedCount == 1);
+}
+
+}
+#endif
+
+int main() {
+    testManyProducers();
+    testCloseAndDrain();
+    testCloseWakesConsumer();
+#ifdef PGSTL_TEST_COROUTINE
+    testCoroutineReadyAndHandOff();
+    testCoroutineResumedOnDestruction();
+    testHandOffCopyThrows();
+    std::printf("channel: coroutine tests passed\n");
+#endif
+    std::printf("channel: passed\n");
+    return 0;
+}
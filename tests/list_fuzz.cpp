@@ -0,0 +1,532 @@
+// pgstl::list 的差分模糊测试和异常安全测试
+// 1. 随机生成操作序列，同时作用在 pgstl::list 和 std::list 上，每一步之后比较两者的内容
+// 2. 用一个可以在第 N 次申请时失败的分配器和一个可以在第 N 次拷贝时抛异常的元素类型，
+//    检查 operator= 的强异常安全保证以及各个构造函数失败时的回滚（没有泄漏节点和元素）
+// 3. 插桩版本的 list<std::string> 能够编译，统计的次数和长度不受 sort 内部临时链表的影响
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "list.h"
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",              \
+                         __FILE__, __LINE__, #cond);                        \
+            std::exit(1);                                                   \
+        }                                                                   \
+    } while (0)
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// 差分模糊测试
+
+// 只按 key 比较大小，用 id 检查 sort / merge 的稳定性
+struct Item {
+    int key;
+    int id;
+
+    bool operator<(const Item &x) const { return key < x.key; }
+    bool operator==(const Item &x) const { return key == x.key && id == x.id; }
+};
+
+using PgList = pgstl::list<Item>;
+using StdList = std::list<Item>;
+
+unsigned long long rngState = 0x2545F4914F6CDD1Dull;
+
+unsigned next() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return unsigned(rngState >> 16);
+}
+
+unsigned nextBelow(unsigned n) { return n ? next() % n : 0; }
+
+int nextId = 0;
+
+Item randomItem() { return Item{int(nextBelow(8)), nextId++}; }
+
+void checkSame(const PgList &a, const StdList &b) {
+    CHECK(a.size() == b.size());
+    CHECK(a.empty() == b.empty());
+
+    StdList::const_iterator j = b.begin();
+    for (PgList::const_iterator i = a.begin(); i != a.end(); ++i, ++j)
+        CHECK(*i == *j);
+    CHECK(j == b.end());
+
+    StdList::const_reverse_iterator rj = b.rbegin();
+    for (PgList::const_reverse_iterator ri = a.rbegin(); ri != a.rend(); ++ri, ++rj)
+        CHECK(*ri == *rj);
+    CHECK(rj == b.rend());
+}
+
+PgList::iterator pgAt(PgList &l, size_t n) {
+    PgList::iterator it = l.begin();
+    while (n--)
+        ++it;
+    return it;
+}
+
+StdList::iterator stdAt(StdList &l, size_t n) {
+    StdList::iterator it = l.begin();
+    while (n--)
+        ++it;
+    return it;
+}
+
+void fuzzOnce() {
+    PgList a, other;
+    StdList b, stdOther;
+
+    for (int step = 0; step < 200; ++step) {
+        size_t n = b.size();
+        switch (nextBelow(20)) {
+            case 0: {
+                Item x = randomItem();
+                a.push_back(x);
+                b.push_back(x);
+                break;
+            }
+            case 1: {
+                Item x = randomItem();
+                a.push_front(x);
+                b.push_front(x);
+                break;
+            }
+            case 2:
+                if (n) {
+                    a.pop_front();
+                    b.pop_front();
+                }
+                break;
+            case 3:
+                if (n) {
+                    a.pop_back();
+                    b.pop_back();
+                }
+                break;
+            case 4: {
+                size_t pos = nextBelow(unsigned(n + 1));
+                Item x = randomItem();
+                a.insert(pgAt(a, pos), x);
+                b.insert(stdAt(b, pos), x);
+                break;
+            }
+            case 5: {
+                size_t pos = nextBelow(unsigned(n + 1));
+                size_t count = nextBelow(4);
+                Item x = randomItem();
+                a.insert(pgAt(a, pos), count, x);
+                b.insert(stdAt(b, pos), count, x);
+                break;
+            }
+            case 6:
+                if (n) {
+                    size_t pos = nextBelow(unsigned(n));
+                    a.erase(pgAt(a, pos));
+                    b.erase(stdAt(b, pos));
+                }
+                break;
+            case 7: {
+                size_t first = nextBelow(unsigned(n + 1));
+                size_t last = first + nextBelow(unsigned(n - first + 1));
+                a.erase(pgAt(a, first), pgAt(a, last));
+                b.erase(stdAt(b, first), stdAt(b, last));
+                break;
+            }
+            case 8: {
+                if (n) {
+                    Item x = *stdAt(b, nextBelow(unsigned(n)));
+                    a.remove(x);
+                    b.remove(x);
+                }
+                break;
+            }
+            case 9: {
+                // Item 的 == 比较 id，unique 只对 key 相同且 id 相同的才去重，
+                // 所以先用 insert 制造一些完全相同的相邻元素
+                if (n) {
+                    size_t pos = nextBelow(unsigned(n));
+                    Item x = *stdAt(b, pos);
+                    a.insert(pgAt(a, pos), x);
+                    b.insert(stdAt(b, pos), x);
+                }
+                a.unique();
+                b.unique();
+                break;
+            }
+            case 10:
+                a.sort();
+                b.sort();
+                break;
+            case 11:
+                a.reverse();
+                b.reverse();
+                break;
+            case 12: {
+                size_t count = nextBelow(6);
+                for (size_t i = 0; i < count; ++i) {
+                    Item x = randomItem();
+                    other.push_back(x);
+                    stdOther.push_back(x);
+                }
+                break;
+            }
+            case 13:
+                a.sort();
+                b.sort();
+                other.sort();
+                stdOther.sort();
+                a.merge(other);
+                b.merge(stdOther);
+                break;
+            case 14: {
+                size_t pos = nextBelow(unsigned(n + 1));
+                a.splice(pgAt(a, pos), other);
+                b.splice(stdAt(b, pos), stdOther);
+                break;
+            }
+            case 15: {
+                size_t m = stdOther.size();
+                if (m) {
+                    size_t pos = nextBelow(unsigned(n + 1));
+                    size_t i = nextBelow(unsigned(m));
+                    a.splice(pgAt(a, pos), other, pgAt(other, i));
+                    b.splice(stdAt(b, pos), stdOther, stdAt(stdOther, i));
+                }
+                break;
+            }
+            case 16: {
+                size_t m = stdOther.size();
+                size_t pos = nextBelow(unsigned(n + 1));
+                size_t first = nextBelow(unsigned(m + 1));
+                size_t last = first + nextBelow(unsigned(m - first + 1));
+                a.splice(pgAt(a, pos), other, pgAt(other, first), pgAt(other, last));
+                b.splice(stdAt(b, pos), stdOther, stdAt(stdOther, first), stdAt(stdOther, last));
+                break;
+            }
+            case 17: {
+                size_t count = nextBelow(unsigned(n + 4));
+                Item x = randomItem();
+                a.resize(count, x);
+                b.resize(count, x);
+                break;
+            }
+            case 18: {
+                PgList copy(a);
+                checkSame(copy, b);
+                other = copy;
+                stdOther = b;
+                break;
+            }
+            case 19:
+                a.swap(other);
+                b.swap(stdOther);
+                break;
+        }
+        checkSame(a, b);
+        checkSame(other, stdOther);
+
+        CHECK((a == other) == (b == stdOther));
+        CHECK((a < other) == (b < stdOther));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 异常安全测试
+
+// 剩余多少次操作后失败，-1 表示永不失败
+long allocBudget = -1;
+long copyBudget = -1;
+long liveAllocations = 0;
+long liveElements = 0;
+
+bool consume(long &budget) {
+    if (budget == 0)
+        return false;
+    if (budget > 0)
+        --budget;
+    return true;
+}
+
+template<class T>
+class failing_allocator : public pgstl::allocator<T> {
+public:
+    template<class U>
+    struct rebind {
+        typedef failing_allocator<U> other;
+    };
+
+    failing_allocator() noexcept = default;
+
+    template<class U>
+    explicit failing_allocator(const failing_allocator<U> &) noexcept {}
+
+    T *allocate(size_t n, const void * = nullptr) {
+        if (!consume(allocBudget))
+            throw std::bad_alloc();
+        ++liveAllocations;
+        return pgstl::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) {
+        --liveAllocations;
+        pgstl::allocator<T>::deallocate(p, n);
+    }
+};
+
+template<class T1, class T2>
+bool operator==(const failing_allocator<T1> &, const failing_allocator<T2> &) { return true; }
+
+template<class T1, class T2>
+bool operator!=(const failing_allocator<T1> &, const failing_allocator<T2> &) { return false; }
+
+struct Tracked {
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++liveElements; }
+    Tracked(const Tracked &x) : value(x.value) {
+        if (!consume(copyBudget))
+            throw std::runtime_error("copy failed");
+        ++liveElements;
+    }
+    ~Tracked() { --liveElements; }
+
+    bool operator==(const Tracked &x) const { return value == x.value; }
+};
+
+using FailList = pgstl::list<Tracked, failing_allocator<Tracked>>;
+
+void fill(FailList &l, int n, int base) {
+    for (int i = 0; i < n; ++i)
+        l.push_back(Tracked(base + i));
+}
+
+bool holds(const FailList &l, int n, int base) {
+    int i = 0;
+    for (FailList::const_iterator it = l.begin(); it != l.end(); ++it, ++i)
+        if (i >= n || it->value != base + i)
+            return false;
+    return i == n;
+}
+
+/**
+ * 对 budget 从 0 开始逐个尝试，直到操作不再抛异常为止
+ * check(threw) 在每次尝试之后检查容器状态
+ */
+template<class Op, class Check>
+void forEachFailurePoint(long &budget, Op op, Check check) {
+    for (long b = 0;; ++b) {
+        bool threw = false;
+        budget = b;
+        try {
+            op();
+        } catch (const std::bad_alloc &) {
+            threw = true;
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        budget = -1;
+        check(threw);
+        if (!threw)
+            break;
+    }
+}
+
+void testAssignStrong(long &budget) {
+    FailList src, dst;
+    fill(src, 8, 100);
+    fill(dst, 3, 0);
+    long allocations = liveAllocations;
+    long elements = liveElements;
+
+    forEachFailurePoint(budget, [&] { dst = src; }, [&](bool threw) {
+        if (threw) {
+            // 强异常安全：失败时 dst 保持原样，临时拷贝全部被释放
+            CHECK(holds(dst, 3, 0));
+            CHECK(liveAllocations == allocations);
+            CHECK(liveElements == elements);
+        } else {
+            CHECK(holds(dst, 8, 100));
+        }
+    });
+}
+
+void testCopyCtorRollback(long &budget) {
+    FailList src;
+    fill(src, 8, 0);
+    long allocations = liveAllocations;
+    long elements = liveElements;
+
+    forEachFailurePoint(budget, [&] {
+        FailList copy(src);
+        CHECK(holds(copy, 8, 0));
+    }, [&](bool) {
+        CHECK(liveAllocations == allocations);
+        CHECK(liveElements == elements);
+    });
+}
+
+void testFillCtorRollback(long &budget) {
+    Tracked value(7);
+    long allocations = liveAllocations;
+    long elements = liveElements;
+
+    forEachFailurePoint(budget, [&] {
+        FailList l(6, value);
+        CHECK(l.size() == 6);
+    }, [&](bool) {
+        CHECK(liveAllocations == allocations);
+        CHECK(liveElements == elements);
+    });
+}
+
+void testRangeCtorRollback(long &budget) {
+    FailList src;
+    fill(src, 5, 10);
+    long allocations = liveAllocations;
+    long elements = liveElements;
+
+    forEachFailurePoint(budget, [&] {
+        FailList l(src.begin(), src.end());
+        CHECK(holds(l, 5, 10));
+    }, [&](bool) {
+        CHECK(liveAllocations == allocations);
+        CHECK(liveElements == elements);
+    });
+}
+
+void testInsertStrong(long &budget) {
+    FailList l;
+    fill(l, 4, 0);
+    Tracked value(9);
+    long allocations = liveAllocations;
+    long elements = liveElements;
+
+    forEachFailurePoint(budget, [&] { l.insert(l.begin(), 5, value); }, [&](bool threw) {
+        if (threw) {
+            CHECK(holds(l, 4, 0));
+            CHECK(liveAllocations == allocations);
+            CHECK(liveElements == elements);
+        } else {
+            CHECK(l.size() == 9);
+        }
+    });
+}
+
+void testPushBackStrong(long &budget) {
+    FailList l;
+    fill(l, 4, 0);
+    Tracked value(4);
+    long allocations = liveAllocations;
+    long elements = liveElements;
+
+    forEachFailurePoint(budget, [&] { l.push_back(value); }, [&](bool threw) {
+        if (threw) {
+            CHECK(holds(l, 4, 0));
+            CHECK(liveAllocations == allocations);
+            CHECK(liveElements == elements);
+        } else {
+            CHECK(holds(l, 5, 0));
+        }
+    });
+}
+
+void testExceptionSafety() {
+    long *budgets[] = {&allocBudget, &copyBudget};
+    for (long *budget : budgets) {
+        testAssignStrong(*budget);
+        testCopyCtorRollback(*budget);
+        testFillCtorRollback(*budget);
+        testRangeCtorRollback(*budget);
+        testInsertStrong(*budget);
+        testPushBackStrong(*budget);
+    }
+    CHECK(liveAllocations == 0);
+    CHECK(liveElements == 0);
+
+    bool threw = false;
+    try {
+        pgstl::allocator<int>().allocate(size_t(-1) / 2);
+    } catch (const std::bad_alloc &) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+}
+
+namespace {
+
+using CountedList = pgstl::list<std::string, pgstl::allocator<std::string>, pgstl::counting_instrument>;
+
+const pgstl::instrument_counter &counter(pgstl::instrument_event e) {
+    return pgstl::instrument_registry::instance().counter(e);
+}
+
+void testInstrumentation() {
+    CountedList l;
+    const char *words[] = {"pear", "fig", "apple", "fig", "kiwi"};
+    for (const char *w : words)
+        l.push_back(w);
+
+    unsigned long long sorts = counter(pgstl::list_sort).calls.load();
+    unsigned long long sortLength = counter(pgstl::list_sort).total_length.load();
+    unsigned long long merges = counter(pgstl::list_merge).calls.load();
+    unsigned long long splices = counter(pgstl::list_splice).calls.load();
+
+    l.sort();
+    l.unique();
+    l.reverse();
+    l.remove("kiwi");
+    CHECK(counter(pgstl::list_sort).calls.load() == sorts + 1);
+    CHECK(counter(pgstl::list_sort).total_length.load() == sortLength + 5);
+    CHECK(counter(pgstl::list_merge).calls.load() == merges);
+
+    CountedList other;
+    other.splice(other.end(), l, l.begin());
+    other.splice(other.end(), l, l.begin(), l.end());
+    l.splice(l.end(), other);
+    CHECK(counter(pgstl::list_splice).calls.load() == splices + 3);
+
+    // 被拒绝的申请不记录长度，否则 n * sizeof(T) 溢出后会污染 max_length
+    bool threw = false;
+    try {
+        pgstl::allocator<int, pgstl::counting_instrument>().allocate(size_t(-1) / 2);
+    } catch (const std::bad_alloc &) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(counter(pgstl::allocator_allocate).max_length.load() < size_t(1) << 32);
+
+    const char *expect[] = {"pear", "fig", "apple"};
+    CountedList::iterator it = l.begin();
+    for (const char *w : expect)
+        CHECK(*it++ == w);
+    CHECK(it == l.end());
+}
+
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 500;
+    if (argc > 2)
+        rngState = std::strtoull(argv[2], nullptr, 0) | 1;
+
+    for (int i = 0; i < iterations; ++i)
+        fuzzOnce();
+    testExceptionSafety();
+    testInstrumentation();
+
+    std::printf("list_fuzz: %d iterations passed\n", iterations);
+    return 0;
+}
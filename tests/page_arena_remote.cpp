@@ -0,0 +1,94 @@
+// page_arena 的跨线程释放测试
+// 节点在一个线程申请、在另一个线程释放时应当回到申请者的内存池并被复用，
+// 申请者线程退出后它的内存池由之后的线程接手，反复的生产者 / 消费者循环不会让页面数增长
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "list.h"
+#include "page_allocator.h"
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",              \
+                         __FILE__, __LINE__, #cond);                        \
+            std::exit(1);                                                   \
+        }                                                                   \
+    } while (0)
+
+namespace {
+
+const size_t blockCount = 100000;
+const size_t blockSize = 24;
+const int rounds = 50;
+
+std::set<uintptr_t> chunks;
+
+void recordChunks(const std::vector<void *> &blocks) {
+    for (void *p : blocks)
+        chunks.insert(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(pgstl::page_arena::chunk_size - 1));
+}
+
+void freeOnOtherThread(std::vector<void *> &blocks) {
+    std::thread consumer([&blocks] {
+        for (void *p : blocks)
+            pgstl::page_arena::local().deallocate(p, blockSize);
+    });
+    consumer.join();
+}
+
+// 每轮都用新的生产者线程，它会接手上一轮退出的线程留下的内存池
+void testShortLivedProducers() {
+    std::vector<void *> blocks(blockCount);
+    for (int r = 0; r < rounds; ++r) {
+        std::thread producer([&blocks] {
+            for (void *&p : blocks)
+                p = pgstl::page_arena::local().allocate(blockSize);
+        });
+        producer.join();
+        recordChunks(blocks);
+        freeOnOtherThread(blocks);
+    }
+}
+
+void testLongLivedProducer() {
+    std::vector<void *> blocks(blockCount);
+    for (int r = 0; r < rounds; ++r) {
+        for (void *&p : blocks)
+            p = pgstl::page_arena::local().allocate(blockSize);
+        recordChunks(blocks);
+        freeOnOtherThread(blocks);
+    }
+}
+
+void testListAcrossThreads() {
+    pgstl::list<int, pgstl::page_allocator<int>> l;
+    std::thread producer([&l] {
+        for (int i = 0; i < 1000; ++i)
+            l.push_back(i);
+    });
+    producer.join();
+
+    long sum = 0;
+    for (int x : l)
+        sum += x;
+    CHECK(sum == 999 * 1000 / 2);
+    l.clear();
+}
+
+}
+
+int main() {
+    testShortLivedProducers();
+    testLongLivedProducer();
+    // 每轮 100000 个 32 字节的块只需要 2 个 2M 的块；不回收的话 100 轮会用掉一百多个
+    CHECK(chunks.size() <= 4);
+    testListAcrossThreads();
+    std::printf("page_arena_remote: %zu chunks used\n", chunks.size());
+    return 0;
+}
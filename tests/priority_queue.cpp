@@ -0,0 +1,187 @@
+// priority_queue 与 merge_k 的测试
+// 1. 随机的 push / pop / replace_top 序列同时作用在 pgstl::priority_queue 和 std::priority_queue 上，
+//    每一步比较 size 和 top，覆盖几种不同的 D 和比较函数
+// 2. 扩容和拷贝构造时元素的拷贝抛出异常，原队列保持不变，没有元素被重复析构或泄漏
+// 3. merge_k 的结果与把各链表按顺序拼接后 std::stable_sort 的结果一致，包括相等元素的先后
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include "list.h"
+#include "merge_k.h"
+#include "priority_queue.h"
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",              \
+                         __FILE__, __LINE__, #cond);                        \
+            std::exit(1);                                                   \
+        }                                                                   \
+    } while (0)
+
+namespace {
+
+unsigned long long rngState = 0x9E3779B97F4A7C15ull;
+
+unsigned next(unsigned n) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return unsigned(rngState >> 33) % n;
+}
+
+// 值域取得很小，让相等的元素经常出现
+template<size_t D, class Compare, class StdCompare>
+void fuzzHeap() {
+    for (int round = 0; round < 50; ++round) {
+        pgstl::priority_queue<int, Compare, D> q;
+        std::priority_queue<int, std::vector<int>, StdCompare> expected;
+        for (int step = 0; step < 2000; ++step) {
+            unsigned op = next(8);
+            int v = int(next(64));
+            if (op < 4 || expected.empty()) {
+                q.push(v);
+                expected.push(v);
+            } else if (op < 6) {
+                q.pop();
+                expected.pop();
+            } else {
+                q.replace_top(v);
+                expected.pop();
+                expected.push(v);
+            }
+            CHECK(q.size() == expected.size());
+            CHECK(q.empty() == expected.empty());
+            if (!expected.empty())
+                CHECK(q.top() == expected.top());
+        }
+        while (!expected.empty()) {
+            CHECK(q.top() == expected.top());
+            q.pop();
+            expected.pop();
+        }
+        CHECK(q.empty());
+    }
+}
+
+// 拷贝次数用完之后再拷贝就抛出异常，live 记录存活的对象个数
+int live = 0;
+int copyBudget = -1;
+
+struct Throwing {
+    int v;
+
+    explicit Throwing(int x) : v(x) { ++live; }
+    Throwing(const Throwing &x) : v(x.v) {
+        if (copyBudget == 0)
+            throw std::runtime_error("copy failed");
+        if (copyBudget > 0)
+            --copyBudget;
+        ++live;
+    }
+    ~Throwing() { --live; }
+
+    bool operator<(const Throwing &x) const { return v < x.v; }
+};
+
+void testExceptionRollback() {
+    {
+        pgstl::priority_queue<Throwing> q;
+        for (int i = 0; i < 8; ++i)
+            q.push(Throwing(i));
+        size_t capacity = q.capacity();
+
+        // 没有 noexcept 移动构造，扩容时逐个拷贝，第三个拷贝失败
+        copyBudget = 2;
+        bool thrown = false;
+        try {
+            q.reserve(capacity * 4);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        copyBudget = -1;
+        CHECK(thrown);
+        CHECK(live == 8);
+        CHECK(q.size() == 8);
+        CHECK(q.capacity() == capacity);
+        CHECK(q.top().v == 7);
+
+        copyBudget = 5;
+        thrown = false;
+        try {
+            pgstl::priority_queue<Throwing> copy(q);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        copyBudget = -1;
+        CHECK(thrown);
+        CHECK(live == 8);
+
+        for (int i = 7; i >= 0; --i) {
+            CHECK(q.top().v == i);
+            q.pop();
+        }
+    }
+    CHECK(live == 0);
+}
+
+// 只按 key 比较，id 记录元素原来的位置，用来检查稳定性
+struct Item {
+    int key;
+    int id;
+
+    bool operator<(const Item &x) const { return key < x.key; }
+};
+
+void testMergeStable() {
+    for (int round = 0; round < 200; ++round) {
+        size_t k = 1 + next(12);
+        std::vector<pgstl::list<Item>> lists(k);
+        std::vector<Item> expected;
+        int id = 0;
+        for (size_t i = 0; i < k; ++i) {
+            // 有一部分链表是空的
+            size_t n = next(4) ? next(40) : 0;
+            std::vector<Item> items;
+            for (size_t j = 0; j < n; ++j)
+                items.push_back(Item{int(next(16)), 0});
+            std::stable_sort(items.begin(), items.end());
+            for (Item &item : items) {
+                item.id = id++;
+                lists[i].push_back(item);
+                expected.push_back(item);
+            }
+        }
+        std::stable_sort(expected.begin(), expected.end());
+
+        pgstl::merge_k(lists.data(), lists.data() + k);
+        std::vector<Item> merged;
+        for (const Item &item : lists[0])
+            merged.push_back(item);
+        CHECK(merged.size() == expected.size());
+        for (size_t i = 0; i < merged.size(); ++i) {
+            CHECK(merged[i].key == expected[i].key);
+            CHECK(merged[i].id == expected[i].id);
+        }
+        for (size_t i = 1; i < k; ++i)
+            CHECK(lists[i].empty());
+    }
+}
+
+}
+
+int main() {
+    fuzzHeap<2, pgstl::less<int>, std::less<int>>();
+    fuzzHeap<4, pgstl::less<int>, std::less<int>>();
+    fuzzHeap<8, pgstl::greater<int>, std::greater<int>>();
+    testExceptionRollback();
+    testMergeStable();
+    std::printf("priority_queue: passed\n");
+    return 0;
+}
@@ -0,0 +1,121 @@
+// concurrent_skip_list 的并发正确性和内存回收测试
+// 1. 多个线程混合插入、查找、删除，结束后检查底层链表有序且与 size() 一致
+// 2. 多个线程反复插入并删除同一批键，检查基于纪元的回收让待回收的节点数保持有界，
+//    collect() 之后不再有多余的节点
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "concurrent_skip_list.h"
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",              \
+                         __FILE__, __LINE__, #cond);                        \
+            std::exit(1);                                                   \
+        }                                                                   \
+    } while (0)
+
+namespace {
+
+const int threadCount = 4;
+
+std::atomic<long> liveAllocations(0);
+
+// 统计尚未释放的节点和索引塔
+template<class T>
+class counting_allocator : public pgstl::allocator<T> {
+public:
+    template<class U>
+    struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() = default;
+    template<class U>
+    counting_allocator(const counting_allocator<U> &) {}
+
+    T *allocate(size_t n, const void * = nullptr) {
+        T *p = pgstl::allocator<T>::allocate(n);
+        liveAllocations.fetch_add(1);
+        return p;
+    }
+    void deallocate(T *p, size_t n) {
+        liveAllocations.fetch_sub(1);
+        pgstl::allocator<T>::deallocate(p, n);
+    }
+};
+
+using SkipList = pgstl::concurrent_skip_list<int, counting_allocator<int>>;
+
+void testMixedOperations() {
+    SkipList s;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&s, t] {
+            unsigned r = unsigned(t) * 7919u + 1;
+            for (int i = 0; i < 50000; ++i) {
+                r = r * 1103515245u + 12345u;
+                int key = int((r >> 8) % 2000);
+                switch ((r >> 4) % 3) {
+                    case 0: s.insert(key); break;
+                    case 1: s.erase(key); break;
+                    default: s.contains(key); break;
+                }
+            }
+        });
+    }
+    for (std::thread &t : threads)
+        t.join();
+
+    size_t n = 0;
+    int prev = -1;
+    for (SkipList::const_iterator it = s.begin(); it != s.end(); ++it, ++n) {
+        CHECK(*it > prev);
+        CHECK(s.contains(*it));
+        prev = *it;
+    }
+    CHECK(n == s.size());
+}
+
+void testBoundedReclamation() {
+    long base = liveAllocations.load();
+    {
+        SkipList s;
+        long empty = liveAllocations.load();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&s, t] {
+                for (int i = 0; i < 100000; ++i) {
+                    int key = t * 1000 + i % 1000;
+                    CHECK(s.insert(key));
+                    CHECK(s.erase(key));
+                }
+            });
+        }
+        for (std::thread &t : threads)
+            t.join();
+        CHECK(s.empty());
+
+        // 每个节点占两次申请（节点和索引塔），没有回收时这里会有 40 万个节点
+        long pending = (liveAllocations.load() - empty) / 2;
+        CHECK(pending <= 3 * long(threadCount) * 64 * 2);
+
+        s.collect();
+        CHECK(liveAllocations.load() == empty);
+    }
+    CHECK(liveAllocations.load() == base);
+}
+
+}
+
+int main() {
+    testMixedOperations();
+    testBoundedReclamation();
+    std::printf("skip_list_reclaim: passed\n");
+    return 0;
+}
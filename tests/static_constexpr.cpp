@@ -0,0 +1,77 @@
+// static_vector / static_list 在 C++20 下的常量表达式支持
+// 所有检查都在编译期完成，能编译通过就说明对应的接口可以在 constexpr 中使用
+
+#include <string>
+
+#include "static_list.h"
+#include "static_vector.h"
+
+#ifndef PGSTL_CONSTEXPR_CONTAINERS
+#error "static_constexpr must be built with C++20 constexpr dynamic allocation support"
+#endif
+
+constexpr int vectorSum() {
+    pgstl::static_vector<int, 8> v(3, 2);
+    v.push_back(5);
+    v.insert(v.begin(), 1);
+    v.erase(v.begin() + 1);
+    pgstl::static_vector<int, 8> copy(v);
+    int sum = 0;
+    for (int x : copy)
+        sum += x;
+    return sum + int(copy.size()) * 100;
+}
+static_assert(vectorSum() == 410, "static_vector in constexpr");
+
+constexpr bool vectorCompare() {
+    const int a[] = {1, 2, 3};
+    const int b[] = {1, 2, 4};
+    pgstl::static_vector<int, 4> x(a, a + 3);
+    pgstl::static_vector<int, 4> y(b, b + 3);
+    return x < y && x != y && !(y <= x);
+}
+static_assert(vectorCompare(), "static_vector comparison in constexpr");
+
+constexpr int listSorted() {
+    const int values[] = {5, 3, 9, 1, 3, 7};
+    pgstl::static_list<int, 8> l(values, values + 6);
+    l.sort();
+    l.unique();
+    l.reverse();
+    l.pop_front();
+    int result = 0;
+    for (int x : l)
+        result = result * 10 + x;
+    return result;
+}
+static_assert(listSorted() == 7531, "static_list sort/unique/reverse in constexpr");
+
+constexpr bool listSplice() {
+    const int a[] = {1, 4};
+    const int b[] = {2, 3};
+    pgstl::static_list<int, 4> x(a, a + 2);
+    pgstl::static_list<int, 4> y(b, b + 2);
+    x.merge(y);
+    pgstl::static_list<int, 4> expect;
+    for (int i = 1; i <= 4; ++i)
+        expect.push_back(i);
+    return x == expect && y.empty() && x.full();
+}
+static_assert(listSplice(), "static_list merge in constexpr");
+
+// 非平凡析构的元素同样可以在常量表达式中构造和析构
+constexpr std::size_t stringElements() {
+    pgstl::static_list<std::string, 4> l;
+    l.push_back("constexpr");
+    l.push_back("list");
+    pgstl::static_vector<std::string, 4> v;
+    v.push_back(l.front());
+    v.push_back(l.back());
+    v.pop_back();
+    return v.front().size() + l.back().size();
+}
+static_assert(stringElements() == 13, "non-trivial elements in constexpr");
+
+int main() {
+    return 0;
+}
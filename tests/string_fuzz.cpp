@@ -0,0 +1,197 @@
+// pgstl::string 的差分模糊测试
+// 随机生成操作序列，同时作用在 pgstl::string 和 std::string 上，每一步之后比较两者的内容。
+// 长度控制在短字符串容量（22）附近来回变化，覆盖短 / 长两种布局之间的切换；
+// 字符中包含 >= 0x80 的字节，检查 compare 与 std::string 的顺序一致
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "basic_string.h"
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",              \
+                         __FILE__, __LINE__, #cond);                        \
+            std::exit(1);                                                   \
+        }                                                                   \
+    } while (0)
+
+namespace {
+
+unsigned long long rngState = 0x9E3779B97F4A7C15ull;
+
+unsigned next(unsigned n) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return unsigned(rngState >> 33) % n;
+}
+
+// 一半是可打印字符，一半是 >= 0x80 的字节
+char randomChar() {
+    return next(2) ? char('a' + next(26)) : char(0x80 + next(128));
+}
+
+int sign(int x) { return (x > 0) - (x < 0); }
+
+void checkSame(const pgstl::string &a, const std::string &b) {
+    CHECK(a.size() == b.size());
+    CHECK(a.capacity() >= a.size());
+    CHECK(std::memcmp(a.data(), b.data(), b.size()) == 0);
+    CHECK(a.c_str()[a.size()] == '\0');
+}
+
+void checkCompare(const pgstl::string &a, const pgstl::string &b,
+                  const std::string &sa, const std::string &sb) {
+    CHECK(sign(a.compare(b)) == sign(sa.compare(sb)));
+    CHECK((a < b) == (sa < sb));
+    CHECK((a == b) == (sa == sb));
+    CHECK((a <= b) == (sa <= sb));
+}
+
+void fuzzOnce() {
+    pgstl::string a, b;
+    std::string sa, sb;
+
+    for (int step = 0; step < 200; ++step) {
+        pgstl::string &x = next(2) ? a : b;
+        std::string &sx = &x == &a ? sa : sb;
+        pgstl::string &y = &x == &a ? b : a;
+        std::string &sy = &x == &a ? sb : sa;
+
+        switch (next(12)) {
+            case 0: {
+                char c = randomChar();
+                x.push_back(c);
+                sx.push_back(c);
+                break;
+            }
+            case 1:
+                if (!sx.empty()) {
+                    x.pop_back();
+                    sx.pop_back();
+                }
+                break;
+            case 2:
+                // 追加自身，源数据在扩容时会被释放
+                x.append(x);
+                sx.append(sx);
+                break;
+            case 3: {
+                // 赋值为自身的子串
+                size_t pos = next(unsigned(sx.size()) + 1);
+                size_t n = next(unsigned(sx.size() - pos) + 1);
+                x.assign(x.data() + pos, n);
+                sx.assign(sx.data() + pos, n);
+                break;
+            }
+            case 4: {
+                // 集中在短字符串容量 22 / 23 附近
+                size_t n = next(4) ? 20 + next(6) : next(48);
+                char c = randomChar();
+                x.resize(n, c);
+                sx.resize(n, c);
+                break;
+            }
+            case 5: {
+                size_t n = next(64);
+                x.reserve(n);
+                sx.reserve(n);
+                CHECK(x.capacity() >= n);
+                break;
+            }
+            case 6:
+                y = std::move(x);
+                sy = std::move(sx);
+                x.clear();
+                sx.clear();
+                break;
+            case 7: {
+                pgstl::string moved(std::move(x));
+                std::string smoved(std::move(sx));
+                checkSame(moved, smoved);
+                checkSame(x, std::string());
+                x = moved;
+                sx = smoved;
+                break;
+            }
+            case 8:
+                x.swap(y);
+                sx.swap(sy);
+                break;
+            case 9:
+                y = x;
+                sy = sx;
+                break;
+            case 10: {
+                char buf[32];
+                size_t n = 21 + next(4);
+                for (size_t i = 0; i < n; ++i)
+                    buf[i] = randomChar();
+                buf[n] = '\0';
+                x = pgstl::string(buf);
+                sx = std::string(buf);
+                break;
+            }
+            default: {
+                // 让 y 成为 x 的前缀再追加一个字节，比较落到后面的字节上
+                size_t n = next(unsigned(sx.size()) + 1);
+                char c = randomChar();
+                y.assign(x.data(), n);
+                sy.assign(sx.data(), n);
+                y.push_back(c);
+                sy.push_back(c);
+                break;
+            }
+        }
+
+        // 防止长度无限增长
+        if (sx.size() > 200) {
+            x.clear();
+            sx.clear();
+        }
+
+        checkSame(a, sa);
+        checkSame(b, sb);
+        checkCompare(a, b, sa, sb);
+    }
+}
+
+void testShortBoundary() {
+    static_assert(sizeof(pgstl::string) == 24, "pgstl::string should be 24 bytes");
+
+    std::string chars(23, 'x');
+    pgstl::string s22(chars.data(), 22);
+    pgstl::string s23(chars.data(), 23);
+    CHECK(s22.capacity() == 22);
+    CHECK(s23.capacity() >= 23);
+    CHECK(s22 < s23);
+
+    s22.push_back('x');
+    CHECK(s22 == s23);
+    s23.pop_back();
+    CHECK(s23.size() == 22);
+
+    const char high[] = {char(0x80), '\0'};
+    CHECK(pgstl::string("a") < pgstl::string(high));
+    CHECK(pgstl::string(high).compare("a") > 0);
+}
+
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 500;
+    if (argc > 2)
+        rngState = std::strtoull(argv[2], nullptr, 0) | 1;
+
+    testShortBoundary();
+    for (int i = 0; i < iterations; ++i)
+        fuzzOnce();
+
+    std::printf("string_fuzz: %d iterations passed\n", iterations);
+    return 0;
+}